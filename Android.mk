@@ -14,10 +14,14 @@ LOCAL_EXPORT_C_INCLUDE_DIRS := $(LOCAL_PATH)/include \
 LOCAL_SRC_FILES += \
     src/CommonAPI/Address.cpp \
     src/CommonAPI/ContainerUtils.cpp \
+    src/CommonAPI/Executor.cpp \
     src/CommonAPI/IniFileReader.cpp \
+    src/CommonAPI/InternedAddress.cpp \
     src/CommonAPI/Logger.cpp \
     src/CommonAPI/LoggerImpl.cpp \
+    src/CommonAPI/MainLoop.cpp \
     src/CommonAPI/MainLoopContext.cpp \
+    src/CommonAPI/SimulatedMainLoop.cpp \
     src/CommonAPI/Proxy.cpp \
     src/CommonAPI/ProxyManager.cpp \
     src/CommonAPI/Runtime.cpp \
@@ -0,0 +1,155 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#if !defined (COMMONAPI_INTERNAL_COMPILATION)
+#error "Only <CommonAPI/CommonAPI.hpp> can be included directly, this file may disappear or change contents."
+#endif
+
+#ifndef COMMONAPI_ATOMIC_SNAPSHOT_HPP_
+#define COMMONAPI_ATOMIC_SNAPSHOT_HPP_
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace CommonAPI {
+
+/**
+ * \brief Immutable value that is read without locks and replaced as a whole
+ *
+ * Readers load a reference to the current value. Loading neither takes a
+ * lock nor allocates, it increments two counters of the snapshot and the
+ * reference count of the value. A value lives until its last reference is
+ * released, thus readers may use it for as long as they need to while the
+ * value is replaced concurrently.
+ *
+ * Writers are serialized. After replacing the value, a writer waits for the
+ * readers that may have seen the replaced value but not yet referenced it.
+ * This is a window of a few instructions without any user code, thus the
+ * wait does not depend on how long readers use the value.
+ *
+ * The reader counters are shared by all readers of a snapshot. Loading from
+ * many threads at once therefore contends on a cache line of the snapshot,
+ * but never on state that is shared with other snapshots.
+ */
+template<typename Value_>
+class AtomicSnapshot {
+    struct Node {
+        template<typename... Arguments_>
+        explicit Node(Arguments_&&... _arguments)
+            : references_(1), value_(std::forward<Arguments_>(_arguments)...) {}
+
+        std::atomic<std::size_t> references_;
+        const Value_ value_;
+    };
+
+public:
+    /**
+     * \brief Reference to a value of the snapshot, empty if no value was stored
+     */
+    class Reference {
+    public:
+        Reference() : node_(nullptr) {}
+        Reference(const Reference &_other) : node_(acquire(_other.node_)) {}
+        Reference(Reference &&_other) noexcept : node_(_other.node_) { _other.node_ = nullptr; }
+        ~Reference() { release(node_); }
+
+        Reference &operator=(Reference _other) noexcept {
+            std::swap(node_, _other.node_);
+            return *this;
+        }
+
+        explicit operator bool() const { return (node_ != nullptr); }
+        const Value_ &operator*() const { return node_->value_; }
+        const Value_ *operator->() const { return &node_->value_; }
+
+    private:
+        friend class AtomicSnapshot;
+        explicit Reference(Node *_node) : node_(_node) {}
+
+        Node *node_;
+    };
+
+    AtomicSnapshot() : current_(nullptr), phase_(0) {
+        readers_[0] = 0;
+        readers_[1] = 0;
+    }
+
+    AtomicSnapshot(const AtomicSnapshot &) = delete;
+    AtomicSnapshot &operator=(const AtomicSnapshot &) = delete;
+
+    ~AtomicSnapshot() {
+        release(current_.load(std::memory_order_acquire));
+    }
+
+    /**
+     * \brief Returns a reference to the current value
+     */
+    Reference load() const {
+        std::size_t itsPhase = phase_.load();
+        readers_[itsPhase].fetch_add(1);
+        Node *itsNode = acquire(current_.load());
+        readers_[itsPhase].fetch_sub(1);
+        return Reference(itsNode);
+    }
+
+    /**
+     * \brief Replaces the current value by a value constructed from the arguments
+     */
+    template<typename... Arguments_>
+    void emplace(Arguments_&&... _arguments) {
+        replace(new Node(std::forward<Arguments_>(_arguments)...));
+    }
+
+    /**
+     * \brief Removes the current value
+     */
+    void reset() {
+        replace(nullptr);
+    }
+
+private:
+    static Node *acquire(Node *_node) {
+        if (_node)
+            _node->references_.fetch_add(1, std::memory_order_relaxed);
+        return _node;
+    }
+
+    static void release(Node *_node) {
+        if (_node && _node->references_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete _node;
+    }
+
+    void replace(Node *_node) {
+        Node *itsReplaced;
+        {
+            std::lock_guard<std::mutex> itsLock(writerMutex_);
+            itsReplaced = current_.exchange(_node);
+
+            // Readers that entered before the exchange may still hold the
+            // replaced node without a reference. Flipping the phase lets new
+            // readers count elsewhere, so each counter drains within the
+            // window of a single load. Both phases must drain, as a reader
+            // may have read the phase long before incrementing its counter.
+            for (int i = 0; i < 2; i++) {
+                std::size_t itsPhase = phase_.load();
+                phase_.store(itsPhase ^ 1);
+                while (readers_[itsPhase].load() != 0)
+                    std::this_thread::yield();
+            }
+        }
+        release(itsReplaced);
+    }
+
+    std::atomic<Node *> current_;
+    std::atomic<std::size_t> phase_;
+    mutable std::atomic<std::size_t> readers_[2];
+    std::mutex writerMutex_;
+};
+
+} // namespace CommonAPI
+
+#endif // COMMONAPI_ATOMIC_SNAPSHOT_HPP_
@@ -15,8 +15,12 @@
 #include "Attribute.hpp"
 #include "AttributeExtension.hpp"
 #include "ByteBuffer.hpp"
+#include "Executor.hpp"
+#include "InternedAddress.hpp"
+#include "MainLoop.hpp"
 #include "MainLoopContext.hpp"
 #include "Runtime.hpp"
+#include "SimulatedMainLoop.hpp"
 #include "Types.hpp"
 
 #ifdef HAS_DEFINED_COMMONAPI_INTERNAL_COMPILATION_HERE
@@ -10,12 +10,20 @@
 #ifndef COMMONAPI_EVENT_HPP_
 #define COMMONAPI_EVENT_HPP_
 
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <map>
 #include <set>
+#include <stdexcept>
 #include <tuple>
+#include <vector>
 
+#include <CommonAPI/AtomicSnapshot.hpp>
+#include <CommonAPI/EventStatistics.hpp>
+#include <CommonAPI/Executor.hpp>
+#include <CommonAPI/InplaceFunction.hpp>
 #include <CommonAPI/Types.hpp>
 
 namespace CommonAPI {
@@ -30,6 +38,8 @@ class Event {
 public:
     typedef std::tuple<Arguments_...> ArgumentsTuple;
     typedef std::function<void(const Arguments_&...)> Listener;
+    typedef std::function<SubscriptionStatus(const Arguments_&...)> CancellableListener;
+    typedef std::function<void(const ArgumentsTuple *, std::size_t)> BatchListener;
     typedef uint32_t Subscription;
     typedef std::set<Subscription> SubscriptionsSet;
     typedef std::function<void(const CallStatus)> ErrorListener;
@@ -39,7 +49,8 @@ public:
     /**
      * \brief Constructor
      */
-    Event() : nextSubscription_(0) {}
+    Event() : hasPendingChanges_(false), numberOfSubscribers_(0),
+              hasPendingLastListenerRemoval_(false), isSerialized_(false) {}
 
     /**
      * \brief Subscribe a listener to this event
@@ -56,21 +67,178 @@ public:
      */
     Subscription subscribe(Listener listener, ErrorListener errorListener = nullptr);
 
+    /**
+     * \brief Subscribe a callable to this event
+     *
+     * Same as subscribe(Listener, ErrorListener), but the event stores the passed
+     * callables themselves instead of a std::function. Callables of up to
+     * COMMONAPI_INPLACE_FUNCTION_CAPACITY bytes are stored without an allocation
+     * and are called without the indirection of a std::function.
+     *
+     * @param _listener A listener to be added
+     * @return key of the new subscription
+     */
+    template<typename Listener_, typename ErrorListener_ = std::nullptr_t,
+             typename = typename std::enable_if<
+                 IsInplaceCallable<Listener_, void(const Arguments_&...)>::value>::type>
+    Subscription subscribe(Listener_ &&_listener, ErrorListener_ &&_errorListener = nullptr);
+
+    /**
+     * \brief Subscribe a cancellable listener to this event
+     *
+     * Subscribe a listener that may end its subscription by returning
+     * SubscriptionStatus::CANCEL. The listener is not called again afterwards,
+     * the subscription is removed by the notifying thread once it has finished
+     * the current notification. This is the preferred way to implement one-shot
+     * listeners.
+     *
+     * @param listener A cancellable listener to be added
+     * @return key of the new subscription
+     */
+    Subscription subscribeCancellable(CancellableListener listener, ErrorListener errorListener = nullptr);
+
+    /**
+     * \brief Subscribe a cancellable callable to this event
+     *
+     * Same as subscribeCancellable(CancellableListener, ErrorListener), but
+     * stores the passed callables inline, see subscribe.
+     *
+     * @param _listener A cancellable listener to be added
+     * @return key of the new subscription
+     */
+    template<typename Listener_, typename ErrorListener_ = std::nullptr_t,
+             typename = typename std::enable_if<
+                 IsInplaceCallable<Listener_, SubscriptionStatus(const Arguments_&...)>::value>::type>
+    Subscription subscribeCancellable(Listener_ &&_listener, ErrorListener_ &&_errorListener = nullptr);
+
+    /**
+     * \brief Subscribe a batch listener to this event
+     *
+     * Subscribe a listener that receives the samples of the event as a contiguous
+     * array of argument tuples. If the event is emitted in bursts, the listener
+     * is called once per burst instead of once per sample. Samples that are
+     * emitted one by one are passed as an array of length one.
+     *
+     * @param listener A batch listener to be added
+     * @return key of the new subscription
+     */
+    Subscription subscribeBatch(BatchListener listener, ErrorListener errorListener = nullptr);
+
+    /**
+     * \brief Subscribe a batch callable to this event
+     *
+     * Same as subscribeBatch(BatchListener, ErrorListener), but stores the
+     * passed callables inline, see subscribe.
+     *
+     * @param _listener A batch listener to be added
+     * @return key of the new subscription
+     */
+    template<typename Listener_, typename ErrorListener_ = std::nullptr_t,
+             typename = typename std::enable_if<
+                 IsInplaceCallable<Listener_, void(const ArgumentsTuple *, std::size_t)>::value>::type>
+    Subscription subscribeBatch(Listener_ &&_listener, ErrorListener_ &&_errorListener = nullptr);
+
+    /**
+     * \brief Subscribe a conflating listener to this event
+     *
+     * Subscribe a listener that is only interested in the latest value of the
+     * event. While the listener is busy (its call is running or, if an executor
+     * is set, waiting for execution), new samples overwrite the pending one
+     * instead of being queued. Once the listener is ready again, it is called
+     * with the newest sample, intermediate samples are skipped. Thus, at most
+     * one sample is buffered per subscription, independent of how much faster
+     * the event is emitted than the listener consumes it.
+     *
+     * @param listener A listener to be added
+     * @return key of the new subscription
+     */
+    Subscription subscribeConflating(Listener listener, ErrorListener errorListener = nullptr);
+
+    /**
+     * \brief Subscribe a conflating callable to this event
+     *
+     * Same as subscribeConflating(Listener, ErrorListener), but stores the
+     * passed callables inline, see subscribe.
+     *
+     * @param _listener A listener to be added
+     * @return key of the new subscription
+     */
+    template<typename Listener_, typename ErrorListener_ = std::nullptr_t,
+             typename = typename std::enable_if<
+                 IsInplaceCallable<Listener_, void(const Arguments_&...)>::value>::type>
+    Subscription subscribeConflating(Listener_ &&_listener, ErrorListener_ &&_errorListener = nullptr);
+
     /**
      * \brief Remove a listener from this event
      *
-     * Remove a listener from this event
-     * Note: Do not call this inside a listener notification callback it will deadlock! Use cancellable listeners instead.
+     * Remove a listener from this event. The listener will not be called anymore
+     * once this method returned, except for a call that is executing concurrently.
+     * It is safe to call this method from inside a listener notification callback,
+     * including the callback of the listener that is removed.
      *
      * @param subscription A listener token to be removed
      */
     void unsubscribe(Subscription subscription);
 
+    /**
+     * \brief Set the executor that calls the listeners of this event
+     *
+     * By default, the listeners are called one after the other on the thread
+     * that emits the event. If an executor is set, each listener call is handed
+     * to the executor instead and the emitting thread returns immediately.
+     * Calls for the same subscription keep their order, calls for different
+     * subscriptions may run concurrently.
+     *
+     * @param _executor The executor to be used, nullptr to call the listeners directly
+     */
+    void setExecutor(std::shared_ptr<Executor> _executor) {
+        if (_executor)
+            executor_.emplace(std::move(_executor));
+        else
+            executor_.reset();
+    }
+
+    /**
+     * \brief Serialize the notifications of this event
+     *
+     * By default, a notification only loads the current list of subscribers,
+     * it neither takes a lock nor waits for concurrent notifications. Thus, the
+     * listeners of an event may be called concurrently if the event is notified
+     * by different threads. If notifications are serialized, a notification
+     * waits until the listener calls of a concurrent notification of the same
+     * event have been completed. Notifications that are triggered by a listener
+     * of the event itself do not wait.
+     *
+     * @param _isSerialized true to serialize the notifications
+     */
+    void setSerializedNotifications(bool _isSerialized) {
+        isSerialized_.store(_isSerialized, std::memory_order_release);
+    }
+
+#ifdef COMMONAPI_ENABLE_EVENT_STATISTICS
+    /**
+     * \brief Get the statistics of this event
+     *
+     * Returns the number of notifications, the subscription churn, the time
+     * spent waiting for the subscription lock, the duration of notifications
+     * and the execution time of each current listener. Only available if
+     * CommonAPI and the application are built with COMMONAPI_ENABLE_EVENT_STATISTICS.
+     */
+    EventStatistics getStatistics() const;
+
+    /**
+     * \brief Reset the statistics of this event
+     */
+    void resetStatistics();
+#endif
+
     virtual ~Event() {}
 
 protected:
     void notifyListeners(const Arguments_&... _eventArguments);
+    void notifyListenersBatch(const ArgumentsTuple *_samples, std::size_t _count);
     void notifySpecificListener(const Subscription _subscription, const Arguments_&... _eventArguments);
+    void notifySpecificListeners(const std::vector<std::pair<Subscription, ArgumentsTuple>> &_notifications);
     void notifySpecificError(const Subscription _subscription, const CallStatus status);
     void notifyErrorListeners(const CallStatus status);
 
@@ -96,37 +264,238 @@ protected:
      * \warning This method acquires a lock on `subscriptionMutex_`.
      */
     std::size_t getSubscriptionCount() const {
-        std::lock_guard<std::mutex> itsSubscriptionLock(subscriptionMutex_);
-        return subscriptions_.size();
+        std::unique_lock<std::mutex> itsSubscriptionLock(lockSubscriptions());
+        return numberOfSubscribers_;
     }
 
 private:
-    ListenersMap subscriptions_;
-    Subscription nextSubscription_;
+    /**
+     * The listeners of a subscription. An entry is shared by all published
+     * subscriber lists, thus a listener keeps its identity (and state)
+     * independent of how often the list is republished.
+     */
+    struct ListenerEntry {
+        ListenerEntry()
+            : isCancelled_(false),
+              isConflating_(false),
+              isDelivering_(false) {
+        }
+
+        // One of the listeners is set, depending on the kind of subscription.
+        // They hold the callables that were passed to subscribe, or the
+        // std::function if the std::function overload was used.
+        InplaceFunction<void(const Arguments_&...)> listener_;
+        InplaceFunction<SubscriptionStatus(const Arguments_&...)> cancellableListener_;
+        InplaceFunction<void(const ArgumentsTuple *, std::size_t)> batchListener_;
+        InplaceFunction<void(const CallStatus)> errorListener_;
+
+        // Passed to the hooks, which expect a std::function. Refers to
+        // the entry weakly, thus it does not keep the entry alive.
+        Listener hookListener_;
+
+        // Set once the subscription was cancelled or removed. Checked
+        // before each call, as the entry may still be referenced by a
+        // list that is currently notified or by an executor task.
+        std::atomic<bool> isCancelled_;
+
+        // Conflating subscriptions only: the newest sample that was not yet
+        // delivered and whether a call of the listener is running or queued.
+        bool isConflating_;
+        std::mutex latestMutex_;
+        std::shared_ptr<const ArgumentsTuple> latest_;
+        bool isDelivering_;
+
+#ifdef COMMONAPI_ENABLE_EVENT_STATISTICS
+        LatencyHistogram latency_;
+#endif
+    };
+
+    struct Subscriber {
+        Subscription subscription_;
+        std::shared_ptr<ListenerEntry> entry_;
+    };
+    typedef std::vector<Subscriber> SubscriberList;
+    typedef typename AtomicSnapshot<SubscriberList>::Reference SubscriberListReference;
+
+    /**
+     * A subscription handle combines the index of its slot with the
+     * generation of the slot. The generation is incremented whenever
+     * the slot is freed, thus stale handles do not match anymore.
+     */
+    static const uint32_t SLOT_INDEX_BITS = 20;
+    static const uint32_t SLOT_INDEX_MASK = (1u << SLOT_INDEX_BITS) - 1;
+    static const uint32_t SLOT_GENERATION_MASK = (1u << (32 - SLOT_INDEX_BITS)) - 1;
+    static const uint32_t SLOT_UNUSED = 0xFFFFFFFF;
+
+    struct Slot {
+        uint32_t generation_;
+        uint32_t position_; // in pendingSubscribers_, SLOT_UNUSED if free
+    };
 
-    ListenersMap pendingSubscriptions_;
-    SubscriptionsSet pendingUnsubscriptions_;
+    std::unique_lock<std::mutex> lockSubscriptions() const;
+    std::unique_lock<std::recursive_mutex> lockNotifications();
+    SubscriberListReference getSubscribers();
+    void publishSubscribers();
+
+    Subscription addSubscriber(std::shared_ptr<ListenerEntry> _entry);
+    uint32_t allocateSlot();
+    Slot *findSlot(const Subscription _subscription);
+    bool removeSubscriber(const Subscription _subscription, std::shared_ptr<ListenerEntry> &_entry,
+                          bool &_isLastListener, const bool _isCancelled = true);
+    std::shared_ptr<ListenerEntry> findEntry(const Subscription _subscription);
+    void removeCancelledSubscribers(const SubscriberList &_subscribers);
+
+    std::shared_ptr<Executor> getExecutor() const {
+        typename AtomicSnapshot<std::shared_ptr<Executor>>::Reference itsExecutor(executor_.load());
+        return (itsExecutor ? *itsExecutor : nullptr);
+    }
+    template<typename Function_>
+    void post(Executor &_executor, std::shared_ptr<ListenerEntry> _entry, Function_ _function) const;
+
+    template<typename ErrorListener_>
+    static std::shared_ptr<ListenerEntry> createEntry(ErrorListener_ &&_errorListener);
+
+    static SubscriptionStatus callListener(ListenerEntry &_entry, const Arguments_&... _eventArguments);
+    static bool invokeListener(ListenerEntry &_entry, const Arguments_&... _eventArguments);
+    static bool invokeBatchListener(ListenerEntry &_entry, const ArgumentsTuple *_samples, std::size_t _count);
+    static void invokeErrorListener(ListenerEntry &_entry, const CallStatus _status);
+
+    void conflate(Executor *_executor, const std::shared_ptr<ListenerEntry> &_entry,
+                  std::shared_ptr<const ArgumentsTuple> _arguments) const;
+    static void deliverLatest(ListenerEntry &_entry);
+
+    // Immutable once published. Notifications only load the current list.
+    // If subscriptions were changed since, the first notification publishes
+    // a compacted copy of pendingSubscribers_ before.
+    AtomicSnapshot<SubscriberList> subscribers_;
+    std::atomic<bool> hasPendingChanges_;
+
+    // Guarded by subscriptionMutex_. Removed subscribers leave a gap (empty
+    // entry) in pendingSubscribers_ until the next publication, which keeps
+    // the order of the remaining subscribers.
+    SubscriberList pendingSubscribers_;
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> freeSlots_;
+    std::size_t numberOfSubscribers_;
+    bool hasPendingLastListenerRemoval_;
+
+    AtomicSnapshot<std::shared_ptr<Executor>> executor_;
 
-    std::mutex notificationMutex_;
     mutable std::mutex subscriptionMutex_;
+
+    // Serializes the notifications, if requested by setSerializedNotifications.
+    // Recursive, as listeners may notify the event again.
+    std::recursive_mutex notificationMutex_;
+    std::atomic<bool> isSerialized_;
+
+#ifdef COMMONAPI_ENABLE_EVENT_STATISTICS
+    mutable EventStatisticsRecorder statistics_;
+#endif
 };
 
 template<typename ... Arguments_>
 typename Event<Arguments_...>::Subscription Event<Arguments_...>::subscribe(Listener listener, ErrorListener errorListener) {
+    return subscribe<Listener, ErrorListener>(std::move(listener), std::move(errorListener));
+}
+
+template<typename ... Arguments_>
+template<typename Listener_, typename ErrorListener_, typename>
+typename Event<Arguments_...>::Subscription Event<Arguments_...>::subscribe(Listener_ &&_listener, ErrorListener_ &&_errorListener) {
+    std::shared_ptr<ListenerEntry> entry = createEntry(std::forward<ErrorListener_>(_errorListener));
+    entry->listener_ = std::forward<Listener_>(_listener);
+    return addSubscriber(std::move(entry));
+}
+
+template<typename ... Arguments_>
+typename Event<Arguments_...>::Subscription Event<Arguments_...>::subscribeCancellable(CancellableListener listener, ErrorListener errorListener) {
+    return subscribeCancellable<CancellableListener, ErrorListener>(std::move(listener), std::move(errorListener));
+}
+
+template<typename ... Arguments_>
+template<typename Listener_, typename ErrorListener_, typename>
+typename Event<Arguments_...>::Subscription Event<Arguments_...>::subscribeCancellable(Listener_ &&_listener, ErrorListener_ &&_errorListener) {
+    std::shared_ptr<ListenerEntry> entry = createEntry(std::forward<ErrorListener_>(_errorListener));
+    entry->cancellableListener_ = std::forward<Listener_>(_listener);
+    return addSubscriber(std::move(entry));
+}
+
+template<typename ... Arguments_>
+typename Event<Arguments_...>::Subscription Event<Arguments_...>::subscribeBatch(BatchListener listener, ErrorListener errorListener) {
+    return subscribeBatch<BatchListener, ErrorListener>(std::move(listener), std::move(errorListener));
+}
+
+template<typename ... Arguments_>
+template<typename Listener_, typename ErrorListener_, typename>
+typename Event<Arguments_...>::Subscription Event<Arguments_...>::subscribeBatch(Listener_ &&_listener, ErrorListener_ &&_errorListener) {
+    std::shared_ptr<ListenerEntry> entry = createEntry(std::forward<ErrorListener_>(_errorListener));
+    entry->batchListener_ = std::forward<Listener_>(_listener);
+    return addSubscriber(std::move(entry));
+}
+
+template<typename ... Arguments_>
+typename Event<Arguments_...>::Subscription Event<Arguments_...>::subscribeConflating(Listener listener, ErrorListener errorListener) {
+    return subscribeConflating<Listener, ErrorListener>(std::move(listener), std::move(errorListener));
+}
+
+template<typename ... Arguments_>
+template<typename Listener_, typename ErrorListener_, typename>
+typename Event<Arguments_...>::Subscription Event<Arguments_...>::subscribeConflating(Listener_ &&_listener, ErrorListener_ &&_errorListener) {
+    std::shared_ptr<ListenerEntry> entry = createEntry(std::forward<ErrorListener_>(_errorListener));
+    entry->listener_ = std::forward<Listener_>(_listener);
+    entry->isConflating_ = true;
+    return addSubscriber(std::move(entry));
+}
+
+template<typename ... Arguments_>
+template<typename ErrorListener_>
+std::shared_ptr<typename Event<Arguments_...>::ListenerEntry> Event<Arguments_...>::createEntry(ErrorListener_ &&_errorListener) {
+    std::shared_ptr<ListenerEntry> entry = std::make_shared<ListenerEntry>();
+    entry->errorListener_ = std::forward<ErrorListener_>(_errorListener);
+
+    // The hooks expect a plain listener
+    std::weak_ptr<ListenerEntry> itsEntry(entry);
+    entry->hookListener_ = [itsEntry](const Arguments_&... _eventArguments) {
+        std::shared_ptr<ListenerEntry> entry = itsEntry.lock();
+        if (entry)
+            (void)callListener(*entry, _eventArguments...);
+    };
+    return entry;
+}
+
+template<typename ... Arguments_>
+typename Event<Arguments_...>::Subscription Event<Arguments_...>::addSubscriber(std::shared_ptr<ListenerEntry> _entry) {
     Subscription subscription;
     bool isFirstListener;
-    Listeners listeners;
+    bool hasPendingLastListenerRemoval;
+    const Listener &listener = _entry->hookListener_;
 
     {
-        std::lock_guard<std::mutex> itsSubscriptionLock(subscriptionMutex_);
-        subscription = nextSubscription_++;
-        isFirstListener = (0 == pendingSubscriptions_.size()) && (pendingUnsubscriptions_.size() == subscriptions_.size());
-        listeners = std::make_tuple(listener, std::move(errorListener));
-        pendingSubscriptions_[subscription] = std::move(listeners);
+        std::unique_lock<std::mutex> itsSubscriptionLock(lockSubscriptions());
+        uint32_t itsIndex = allocateSlot();
+        Slot &itsSlot = slots_[itsIndex];
+        itsSlot.position_ = static_cast<uint32_t>(pendingSubscribers_.size());
+        subscription = ((itsSlot.generation_ << SLOT_INDEX_BITS) | itsIndex);
+
+        pendingSubscribers_.push_back({ subscription, _entry });
+        hasPendingChanges_.store(true, std::memory_order_release);
+
+        isFirstListener = (0 == numberOfSubscribers_++);
+#ifdef COMMONAPI_ENABLE_EVENT_STATISTICS
+        statistics_.subscriptions_.fetch_add(1, std::memory_order_relaxed);
+#endif
+
+        // Keep the gaps bounded if subscriptions change without notifications
+        if (pendingSubscribers_.size() > 2 * numberOfSubscribers_ + 16)
+            publishSubscribers();
+
+        hasPendingLastListenerRemoval = (isFirstListener && hasPendingLastListenerRemoval_);
+        hasPendingLastListenerRemoval_ = false;
     }
 
     if (isFirstListener) {
-        if (!pendingUnsubscriptions_.empty())
+        // The last listener was removed by an error notification,
+        // which does not call the removal hooks. Do it now.
+        if (hasPendingLastListenerRemoval)
             onLastListenerRemoved(listener);
         onFirstListenerAdded(listener);
     }
@@ -139,173 +508,543 @@ template<typename ... Arguments_>
 void Event<Arguments_...>::unsubscribe(const Subscription subscription) {
     bool isLastListener(false);
     bool hasUnsubscribed(false);
-    Listener listener;
+    std::shared_ptr<ListenerEntry> entry;
 
     {
-        std::lock_guard<std::mutex> itsSubscriptionLock(subscriptionMutex_);
-        auto listenerIterator = subscriptions_.find(subscription);
-        if (subscriptions_.end() != listenerIterator) {
-            if (pendingUnsubscriptions_.end() == pendingUnsubscriptions_.find(subscription)) {
-                if (0 == pendingSubscriptions_.erase(subscription)) {
-                    pendingUnsubscriptions_.insert(subscription);
-                    listener = std::get<0>(listenerIterator->second);
-                    hasUnsubscribed = true;
-                }
-                isLastListener = (pendingUnsubscriptions_.size() == subscriptions_.size());
-            }
-        }
-        else {
-            listenerIterator = pendingSubscriptions_.find(subscription);
-            if (pendingSubscriptions_.end() != listenerIterator) {
-                listener = std::get<0>(listenerIterator->second);
-                if (0 != pendingSubscriptions_.erase(subscription)) {
-                    isLastListener = (pendingUnsubscriptions_.size() == subscriptions_.size());
-                    hasUnsubscribed = true;
-                }
-            }
-        }
-        isLastListener = isLastListener && (0 == pendingSubscriptions_.size());
+        std::unique_lock<std::mutex> itsSubscriptionLock(lockSubscriptions());
+        hasUnsubscribed = removeSubscriber(subscription, entry, isLastListener);
     }
 
     if (hasUnsubscribed) {
-        onListenerRemoved(listener, subscription);
+        onListenerRemoved(entry->hookListener_, subscription);
         if (isLastListener) {
-            onLastListenerRemoved(listener);
+            onLastListenerRemoved(entry->hookListener_);
         }
     }
 }
 
 template<typename ... Arguments_>
-void Event<Arguments_...>::notifyListeners(const Arguments_&... eventArguments) {
+uint32_t Event<Arguments_...>::allocateSlot() {
+    if (!freeSlots_.empty()) {
+        uint32_t itsIndex = freeSlots_.back();
+        freeSlots_.pop_back();
+        return itsIndex;
+    }
+
+    if (slots_.size() > SLOT_INDEX_MASK)
+        throw std::length_error("CommonAPI::Event: too many subscriptions");
+
+    slots_.push_back({ 0, SLOT_UNUSED });
+    return static_cast<uint32_t>(slots_.size() - 1);
+}
+
+template<typename ... Arguments_>
+typename Event<Arguments_...>::Slot *Event<Arguments_...>::findSlot(const Subscription _subscription) {
+    uint32_t itsIndex = (_subscription & SLOT_INDEX_MASK);
+    if (itsIndex >= slots_.size())
+        return nullptr;
+
+    Slot &itsSlot = slots_[itsIndex];
+    if (itsSlot.position_ == SLOT_UNUSED
+            || itsSlot.generation_ != (_subscription >> SLOT_INDEX_BITS))
+        return nullptr;
+
+    return &itsSlot;
+}
+
+template<typename ... Arguments_>
+bool Event<Arguments_...>::removeSubscriber(const Subscription _subscription,
+                                            std::shared_ptr<ListenerEntry> &_entry, bool &_isLastListener,
+                                            const bool _isCancelled) {
+    Slot *itsSlot = findSlot(_subscription);
+    if (!itsSlot)
+        return false;
+
+    Subscriber &itsSubscriber = pendingSubscribers_[itsSlot->position_];
+    if (_isCancelled)
+        itsSubscriber.entry_->isCancelled_.store(true, std::memory_order_release);
+    _entry = std::move(itsSubscriber.entry_);
+    hasPendingChanges_.store(true, std::memory_order_release);
+
+    // A slot whose generation wraps is retired, unless no more slots
+    // can be created, to keep stale handles from matching again.
+    itsSlot->position_ = SLOT_UNUSED;
+    itsSlot->generation_ = ((itsSlot->generation_ + 1) & SLOT_GENERATION_MASK);
+    if (itsSlot->generation_ != 0 || slots_.size() > SLOT_INDEX_MASK)
+        freeSlots_.push_back(_subscription & SLOT_INDEX_MASK);
 
-    std::lock_guard<std::mutex> itsNotificationLock(notificationMutex_);
-    std::unique_lock<std::mutex> itsSubscriptionLock(subscriptionMutex_);
-    for (auto iterator = pendingUnsubscriptions_.begin();
-         iterator != pendingUnsubscriptions_.end();
-         iterator++) {
-        subscriptions_.erase(*iterator);
+    _isLastListener = (0 == --numberOfSubscribers_);
+#ifdef COMMONAPI_ENABLE_EVENT_STATISTICS
+    statistics_.unsubscriptions_.fetch_add(1, std::memory_order_relaxed);
+#endif
+    return true;
+}
+
+template<typename ... Arguments_>
+std::unique_lock<std::mutex> Event<Arguments_...>::lockSubscriptions() const {
+#ifdef COMMONAPI_ENABLE_EVENT_STATISTICS
+    std::unique_lock<std::mutex> itsLock(subscriptionMutex_, std::try_to_lock);
+    if (itsLock.owns_lock()) {
+        statistics_.lockWait_.record(std::chrono::nanoseconds::zero());
+    } else {
+        LatencyScope itsScope(statistics_.lockWait_);
+        itsLock.lock();
     }
-    pendingUnsubscriptions_.clear();
+    return itsLock;
+#else
+    return std::unique_lock<std::mutex>(subscriptionMutex_);
+#endif
+}
+
+template<typename ... Arguments_>
+std::unique_lock<std::recursive_mutex> Event<Arguments_...>::lockNotifications() {
+    if (isSerialized_.load(std::memory_order_acquire))
+        return std::unique_lock<std::recursive_mutex>(notificationMutex_);
+    return std::unique_lock<std::recursive_mutex>();
+}
+
+template<typename ... Arguments_>
+typename Event<Arguments_...>::SubscriberListReference Event<Arguments_...>::getSubscribers() {
+    if (hasPendingChanges_.load(std::memory_order_acquire)) {
+        std::unique_lock<std::mutex> itsSubscriptionLock(lockSubscriptions());
+        if (hasPendingChanges_.load(std::memory_order_relaxed))
+            publishSubscribers();
+    }
+    return subscribers_.load();
+}
+
+template<typename ... Arguments_>
+void Event<Arguments_...>::publishSubscribers() {
+    SubscriberList itsSubscribers;
+    itsSubscribers.reserve(numberOfSubscribers_);
 
-    for (auto iterator = pendingSubscriptions_.begin();
-         iterator != pendingSubscriptions_.end();
-         iterator++) {
-        subscriptions_.insert(*iterator);
+    // Close the gaps of removed subscribers
+    uint32_t itsPosition(0);
+    for (Subscriber &itsSubscriber : pendingSubscribers_) {
+        if (itsSubscriber.entry_) {
+            slots_[itsSubscriber.subscription_ & SLOT_INDEX_MASK].position_ = itsPosition;
+            if (&itsSubscriber != &pendingSubscribers_[itsPosition])
+                pendingSubscribers_[itsPosition] = std::move(itsSubscriber);
+            itsSubscribers.push_back(pendingSubscribers_[itsPosition]);
+            itsPosition++;
+        }
     }
-    pendingSubscriptions_.clear();
+    pendingSubscribers_.resize(itsPosition);
+
+    if (itsSubscribers.empty())
+        subscribers_.reset();
+    else
+        subscribers_.emplace(std::move(itsSubscribers));
+    hasPendingChanges_.store(false, std::memory_order_release);
+#ifdef COMMONAPI_ENABLE_EVENT_STATISTICS
+    statistics_.publications_.fetch_add(1, std::memory_order_relaxed);
+#endif
+}
 
-    itsSubscriptionLock.unlock();
-    for (auto iterator = subscriptions_.begin(); iterator != subscriptions_.end(); iterator++) {
-        (std::get<0>(iterator->second))(eventArguments...);
+template<typename ... Arguments_>
+void Event<Arguments_...>::removeCancelledSubscribers(const SubscriberList &_subscribers) {
+    for (const Subscriber &itsSubscriber : _subscribers) {
+        if (itsSubscriber.entry_->isCancelled_.load(std::memory_order_acquire))
+            unsubscribe(itsSubscriber.subscription_);
     }
 }
 
 template<typename ... Arguments_>
-void Event<Arguments_...>::notifySpecificListener(const Subscription subscription, const Arguments_&... eventArguments) {
+SubscriptionStatus Event<Arguments_...>::callListener(ListenerEntry &_entry, const Arguments_&... _eventArguments) {
+    if (_entry.cancellableListener_)
+        return _entry.cancellableListener_(_eventArguments...);
 
-    std::lock_guard<std::mutex> itsNotificationLock(notificationMutex_);
-    std::unique_lock<std::mutex> itsSubscriptionLock(subscriptionMutex_);
-    for (auto iterator = pendingUnsubscriptions_.begin();
-         iterator != pendingUnsubscriptions_.end();
-         iterator++) {
-        subscriptions_.erase(*iterator);
+    if (_entry.batchListener_) {
+        ArgumentsTuple itsSample(_eventArguments...);
+        _entry.batchListener_(&itsSample, 1);
+    } else {
+        _entry.listener_(_eventArguments...);
     }
-    pendingUnsubscriptions_.clear();
+    return SubscriptionStatus::RETAIN;
+}
+
+template<typename ... Arguments_>
+bool Event<Arguments_...>::invokeListener(ListenerEntry &_entry, const Arguments_&... _eventArguments) {
+    if (_entry.isCancelled_.load(std::memory_order_acquire))
+        return false;
 
-    for (auto iterator = pendingSubscriptions_.begin();
-         iterator != pendingSubscriptions_.end();
-         iterator++) {
+#ifdef COMMONAPI_ENABLE_EVENT_STATISTICS
+    LatencyScope itsScope(_entry.latency_);
+#endif
+    if (callListener(_entry, _eventArguments...) == SubscriptionStatus::CANCEL) {
+        _entry.isCancelled_.store(true, std::memory_order_release);
+        return false;
+    }
+    return true;
+}
 
-        subscriptions_.insert(*iterator);
+template<typename ... Arguments_>
+bool Event<Arguments_...>::invokeBatchListener(ListenerEntry &_entry, const ArgumentsTuple *_samples, std::size_t _count) {
+    if (_entry.batchListener_) {
+        if (_entry.isCancelled_.load(std::memory_order_acquire))
+            return false;
+#ifdef COMMONAPI_ENABLE_EVENT_STATISTICS
+        LatencyScope itsScope(_entry.latency_);
+#endif
+        _entry.batchListener_(_samples, _count);
+        return true;
     }
-    pendingSubscriptions_.clear();
 
-    itsSubscriptionLock.unlock();
-    for (auto iterator = subscriptions_.begin(); iterator != subscriptions_.end(); iterator++) {
-        if (subscription == iterator->first) {
-            (std::get<0>(iterator->second))(eventArguments...);
-        }
+    // Unroll the batch for listeners that expect single samples
+    for (std::size_t i = 0; i < _count; i++) {
+        bool isRetained = std::apply([&_entry](const Arguments_&... _eventArguments) {
+            return invokeListener(_entry, _eventArguments...);
+        }, _samples[i]);
+        if (!isRetained)
+            return false;
     }
+    return true;
 }
 
 template<typename ... Arguments_>
-void Event<Arguments_...>::notifySpecificError(const Subscription subscription, const CallStatus status) {
+void Event<Arguments_...>::invokeErrorListener(ListenerEntry &_entry, const CallStatus _status) {
+    if (_entry.errorListener_ && !_entry.isCancelled_.load(std::memory_order_acquire)) {
+#ifdef COMMONAPI_ENABLE_EVENT_STATISTICS
+        LatencyScope itsScope(_entry.latency_);
+#endif
+        _entry.errorListener_(_status);
+    }
+}
 
+template<typename ... Arguments_>
+void Event<Arguments_...>::conflate(Executor *_executor, const std::shared_ptr<ListenerEntry> &_entry,
+                                    std::shared_ptr<const ArgumentsTuple> _arguments) const {
     {
-        std::lock_guard<std::mutex> itsNotificationLock(notificationMutex_);
-        std::unique_lock<std::mutex> itsSubscriptionLock(subscriptionMutex_);
-        for (auto iterator = pendingUnsubscriptions_.begin();
-             iterator != pendingUnsubscriptions_.end();
-             iterator++) {
-            subscriptions_.erase(*iterator);
+        std::lock_guard<std::mutex> itsLatestLock(_entry->latestMutex_);
+        _entry->latest_ = std::move(_arguments);
+        if (_entry->isDelivering_)
+            return; // picked up by the running delivery
+        _entry->isDelivering_ = true;
+    }
+
+    if (_executor) {
+        post(*_executor, _entry, [](ListenerEntry &_entry) {
+            deliverLatest(_entry);
+        });
+    } else {
+        deliverLatest(*_entry);
+    }
+}
+
+template<typename ... Arguments_>
+void Event<Arguments_...>::deliverLatest(ListenerEntry &_entry) {
+    while (true) {
+        std::shared_ptr<const ArgumentsTuple> itsLatest;
+        {
+            std::lock_guard<std::mutex> itsLatestLock(_entry.latestMutex_);
+            itsLatest = std::move(_entry.latest_);
+            if (!itsLatest || _entry.isCancelled_.load(std::memory_order_acquire)) {
+                _entry.latest_.reset();
+                _entry.isDelivering_ = false;
+                return;
+            }
         }
-        pendingUnsubscriptions_.clear();
 
-        for (auto iterator = pendingSubscriptions_.begin();
-             iterator != pendingSubscriptions_.end();
-             iterator++) {
-            subscriptions_.insert(*iterator);
+        std::apply([&_entry](const Arguments_&... _eventArguments) {
+            (void)invokeListener(_entry, _eventArguments...);
+        }, *itsLatest);
+    }
+}
+
+template<typename ... Arguments_>
+template<typename Function_>
+void Event<Arguments_...>::post(Executor &_executor, std::shared_ptr<ListenerEntry> _entry, Function_ _function) const {
+    // The entry is kept alive by the task, as the task may be
+    // executed after the subscription has been removed.
+    std::size_t key = reinterpret_cast<std::size_t>(_entry.get());
+    _executor.execute(key, [_entry, _function]() {
+        _function(*_entry);
+    });
+}
+
+template<typename ... Arguments_>
+void Event<Arguments_...>::notifyListeners(const Arguments_&... eventArguments) {
+#ifdef COMMONAPI_ENABLE_EVENT_STATISTICS
+    statistics_.notifications_.fetch_add(1, std::memory_order_relaxed);
+    LatencyScope itsScope(statistics_.notification_);
+#endif
+    std::unique_lock<std::recursive_mutex> itsNotificationLock(lockNotifications());
+    SubscriberListReference subscribers = getSubscribers();
+    if (!subscribers)
+        return;
+
+    // Subscriptions cancelled by their listener are removed after the
+    // notification has been completed. With an executor, this happens
+    // with the next notification after the listener cancelled.
+    bool hasCancelled(false);
+    std::shared_ptr<Executor> executor = getExecutor();
+    if (executor) {
+        std::shared_ptr<const ArgumentsTuple> arguments
+            = std::make_shared<const ArgumentsTuple>(eventArguments...);
+        for (const Subscriber &itsSubscriber : *subscribers) {
+            if (itsSubscriber.entry_->isCancelled_.load(std::memory_order_acquire)) {
+                hasCancelled = true;
+                continue;
+            }
+            if (itsSubscriber.entry_->isConflating_) {
+                conflate(executor.get(), itsSubscriber.entry_, arguments);
+                continue;
+            }
+            post(*executor, itsSubscriber.entry_, [arguments](ListenerEntry &_entry) {
+                std::apply([&_entry](const Arguments_&... _eventArguments) {
+                    (void)invokeListener(_entry, _eventArguments...);
+                }, *arguments);
+            });
         }
-        pendingSubscriptions_.clear();
-
-        itsSubscriptionLock.unlock();
-        for (auto iterator = subscriptions_.begin(); iterator != subscriptions_.end(); iterator++) {
-            if (subscription == iterator->first) {
-                ErrorListener listener = std::get<1>(iterator->second);
-                if (listener) {
-                    listener(status);
-                }
+    } else {
+        // Only created if there are conflating listeners
+        std::shared_ptr<const ArgumentsTuple> arguments;
+        for (const Subscriber &itsSubscriber : *subscribers) {
+            if (itsSubscriber.entry_->isConflating_) {
+                if (!arguments)
+                    arguments = std::make_shared<const ArgumentsTuple>(eventArguments...);
+                conflate(nullptr, itsSubscriber.entry_, arguments);
+            } else if (!invokeListener(*itsSubscriber.entry_, eventArguments...)) {
+                hasCancelled = true;
             }
         }
     }
 
-    if (status != CommonAPI::CallStatus::SUCCESS) {
-        std::lock_guard<std::mutex> itsSubscriptionLock(subscriptionMutex_);
-        auto listenerIterator = subscriptions_.find(subscription);
-        if (subscriptions_.end() != listenerIterator) {
-            if (pendingUnsubscriptions_.end() == pendingUnsubscriptions_.find(subscription)) {
-                if (0 == pendingSubscriptions_.erase(subscription)) {
-                    pendingUnsubscriptions_.insert(subscription);
-                }
+    if (hasCancelled)
+        removeCancelledSubscribers(*subscribers);
+}
+
+template<typename ... Arguments_>
+void Event<Arguments_...>::notifyListenersBatch(const ArgumentsTuple *_samples, std::size_t _count) {
+#ifdef COMMONAPI_ENABLE_EVENT_STATISTICS
+    statistics_.notifications_.fetch_add(1, std::memory_order_relaxed);
+    LatencyScope itsScope(statistics_.notification_);
+#endif
+    if (0 == _count)
+        return;
+
+    std::unique_lock<std::recursive_mutex> itsNotificationLock(lockNotifications());
+    SubscriberListReference subscribers = getSubscribers();
+    if (!subscribers)
+        return;
+
+    bool hasCancelled(false);
+    std::shared_ptr<Executor> executor = getExecutor();
+    if (executor) {
+        std::shared_ptr<const std::vector<ArgumentsTuple>> samples
+            = std::make_shared<const std::vector<ArgumentsTuple>>(_samples, _samples + _count);
+        for (const Subscriber &itsSubscriber : *subscribers) {
+            if (itsSubscriber.entry_->isCancelled_.load(std::memory_order_acquire)) {
+                hasCancelled = true;
+                continue;
             }
+            if (itsSubscriber.entry_->isConflating_) {
+                // Only the newest sample of the batch is of interest
+                conflate(executor.get(), itsSubscriber.entry_,
+                         std::shared_ptr<const ArgumentsTuple>(samples, &samples->back()));
+                continue;
+            }
+            post(*executor, itsSubscriber.entry_, [samples](ListenerEntry &_entry) {
+                (void)invokeBatchListener(_entry, samples->data(), samples->size());
+            });
         }
-        else {
-            listenerIterator = pendingSubscriptions_.find(subscription);
-            if (pendingSubscriptions_.end() != listenerIterator) {
-                pendingSubscriptions_.erase(subscription);
+    } else {
+        std::shared_ptr<const ArgumentsTuple> latest;
+        for (const Subscriber &itsSubscriber : *subscribers) {
+            if (itsSubscriber.entry_->isConflating_) {
+                if (!latest)
+                    latest = std::make_shared<const ArgumentsTuple>(_samples[_count - 1]);
+                conflate(nullptr, itsSubscriber.entry_, latest);
+            } else if (!invokeBatchListener(*itsSubscriber.entry_, _samples, _count)) {
+                hasCancelled = true;
             }
         }
     }
+
+    if (hasCancelled)
+        removeCancelledSubscribers(*subscribers);
 }
 
 template<typename ... Arguments_>
-void Event<Arguments_...>::notifyErrorListeners(const CallStatus status) {
+std::shared_ptr<typename Event<Arguments_...>::ListenerEntry> Event<Arguments_...>::findEntry(const Subscription _subscription) {
+    std::unique_lock<std::mutex> itsSubscriptionLock(lockSubscriptions());
+    Slot *itsSlot = findSlot(_subscription);
+    return (itsSlot ? pendingSubscribers_[itsSlot->position_].entry_ : nullptr);
+}
+
+template<typename ... Arguments_>
+void Event<Arguments_...>::notifySpecificListener(const Subscription subscription, const Arguments_&... eventArguments) {
+#ifdef COMMONAPI_ENABLE_EVENT_STATISTICS
+    statistics_.notifications_.fetch_add(1, std::memory_order_relaxed);
+    LatencyScope itsScope(statistics_.notification_);
+#endif
+    std::unique_lock<std::recursive_mutex> itsNotificationLock(lockNotifications());
+    std::shared_ptr<ListenerEntry> entry = findEntry(subscription);
+    if (!entry)
+        return;
+
+    std::shared_ptr<Executor> executor = getExecutor();
+    if (entry->isConflating_) {
+        conflate(executor.get(), entry, std::make_shared<const ArgumentsTuple>(eventArguments...));
+    } else if (executor) {
+        ArgumentsTuple arguments(eventArguments...);
+        post(*executor, std::move(entry), [arguments](ListenerEntry &_entry) {
+            std::apply([&_entry](const Arguments_&... _eventArguments) {
+                (void)invokeListener(_entry, _eventArguments...);
+            }, arguments);
+        });
+    } else if (!invokeListener(*entry, eventArguments...)) {
+        unsubscribe(subscription);
+    }
+}
+
+template<typename ... Arguments_>
+void Event<Arguments_...>::notifySpecificListeners(
+        const std::vector<std::pair<Subscription, ArgumentsTuple>> &_notifications) {
+#ifdef COMMONAPI_ENABLE_EVENT_STATISTICS
+    statistics_.notifications_.fetch_add(1, std::memory_order_relaxed);
+    LatencyScope itsScope(statistics_.notification_);
+#endif
+    std::unique_lock<std::recursive_mutex> itsNotificationLock(lockNotifications());
+
+    // Resolve all subscriptions with a single lock acquisition
+    std::vector<std::shared_ptr<ListenerEntry>> entries;
+    entries.reserve(_notifications.size());
+    {
+        std::unique_lock<std::mutex> itsSubscriptionLock(lockSubscriptions());
+        for (const auto &itsNotification : _notifications) {
+            Slot *itsSlot = findSlot(itsNotification.first);
+            entries.push_back(itsSlot ? pendingSubscribers_[itsSlot->position_].entry_ : nullptr);
+        }
+    }
+
+    std::shared_ptr<Executor> executor = getExecutor();
+    for (std::size_t i = 0; i < _notifications.size(); i++) {
+        if (!entries[i])
+            continue;
+
+        const ArgumentsTuple &arguments = _notifications[i].second;
+        if (entries[i]->isConflating_) {
+            conflate(executor.get(), entries[i], std::make_shared<const ArgumentsTuple>(arguments));
+        } else if (executor) {
+            post(*executor, std::move(entries[i]), [arguments](ListenerEntry &_entry) {
+                std::apply([&_entry](const Arguments_&... _eventArguments) {
+                    (void)invokeListener(_entry, _eventArguments...);
+                }, arguments);
+            });
+        } else {
+            ListenerEntry &itsEntry = *entries[i];
+            bool isRetained = std::apply([&itsEntry](const Arguments_&... _eventArguments) {
+                return invokeListener(itsEntry, _eventArguments...);
+            }, arguments);
+            if (!isRetained)
+                unsubscribe(_notifications[i].first);
+        }
+    }
+}
+
+template<typename ... Arguments_>
+void Event<Arguments_...>::notifySpecificError(const Subscription subscription, const CallStatus status) {
+#ifdef COMMONAPI_ENABLE_EVENT_STATISTICS
+    statistics_.notifications_.fetch_add(1, std::memory_order_relaxed);
+    LatencyScope itsScope(statistics_.notification_);
+#endif
+    std::unique_lock<std::recursive_mutex> itsNotificationLock(lockNotifications());
+    std::shared_ptr<ListenerEntry> entry = findEntry(subscription);
+    if (!entry)
+        return;
 
-    std::lock_guard<std::mutex> itsNotificationLock(notificationMutex_);
-    std::unique_lock<std::mutex> itsSubscriptionLock(subscriptionMutex_);
-    for (auto iterator = pendingUnsubscriptions_.begin();
-         iterator != pendingUnsubscriptions_.end();
-         iterator++) {
-        subscriptions_.erase(*iterator);
+    std::shared_ptr<Executor> executor = getExecutor();
+    if (status == CommonAPI::CallStatus::SUCCESS) {
+        if (executor) {
+            post(*executor, std::move(entry), [status](ListenerEntry &_entry) {
+                invokeErrorListener(_entry, status);
+            });
+        } else {
+            invokeErrorListener(*entry, status);
+        }
+        return;
     }
-    pendingUnsubscriptions_.clear();
 
-    for (auto iterator = pendingSubscriptions_.begin();
-         iterator != pendingSubscriptions_.end();
-         iterator++) {
-        subscriptions_.insert(*iterator);
+    if (!executor)
+        invokeErrorListener(*entry, status);
+
+    // Remove the subscription without calling the removal hooks. With an
+    // executor, the entry is cancelled by the task after it called the error
+    // listener, as a cancelled entry does not call its listeners anymore.
+    bool isRemoved(false);
+    bool isLastListener(false);
+    {
+        std::unique_lock<std::mutex> itsSubscriptionLock(lockSubscriptions());
+        isRemoved = removeSubscriber(subscription, entry, isLastListener, !executor);
+        if (isRemoved && isLastListener)
+            hasPendingLastListenerRemoval_ = true;
     }
-    pendingSubscriptions_.clear();
 
-    itsSubscriptionLock.unlock();
-    for (auto iterator = subscriptions_.begin(); iterator != subscriptions_.end(); iterator++) {
-        ErrorListener listener = std::get<1>(iterator->second);
-        if (listener) {
-            listener(status);
+    if (executor && isRemoved) {
+        post(*executor, std::move(entry), [status](ListenerEntry &_entry) {
+            invokeErrorListener(_entry, status);
+            _entry.isCancelled_.store(true, std::memory_order_release);
+        });
+    }
+}
+
+template<typename ... Arguments_>
+void Event<Arguments_...>::notifyErrorListeners(const CallStatus status) {
+#ifdef COMMONAPI_ENABLE_EVENT_STATISTICS
+    statistics_.notifications_.fetch_add(1, std::memory_order_relaxed);
+    LatencyScope itsScope(statistics_.notification_);
+#endif
+    std::unique_lock<std::recursive_mutex> itsNotificationLock(lockNotifications());
+    SubscriberListReference subscribers = getSubscribers();
+    if (!subscribers)
+        return;
+
+    std::shared_ptr<Executor> executor = getExecutor();
+    for (const Subscriber &itsSubscriber : *subscribers) {
+        if (executor) {
+            post(*executor, itsSubscriber.entry_, [status](ListenerEntry &_entry) {
+                invokeErrorListener(_entry, status);
+            });
+        } else {
+            invokeErrorListener(*itsSubscriber.entry_, status);
         }
     }
 }
 
+#ifdef COMMONAPI_ENABLE_EVENT_STATISTICS
+template<typename ... Arguments_>
+EventStatistics Event<Arguments_...>::getStatistics() const {
+    EventStatistics itsStatistics;
+    itsStatistics.notifications_ = statistics_.notifications_.load(std::memory_order_relaxed);
+    itsStatistics.subscriptions_ = statistics_.subscriptions_.load(std::memory_order_relaxed);
+    itsStatistics.unsubscriptions_ = statistics_.unsubscriptions_.load(std::memory_order_relaxed);
+    itsStatistics.publications_ = statistics_.publications_.load(std::memory_order_relaxed);
+    itsStatistics.lockWait_ = statistics_.lockWait_.getSnapshot();
+    itsStatistics.notification_ = statistics_.notification_.getSnapshot();
+
+    std::unique_lock<std::mutex> itsSubscriptionLock(lockSubscriptions());
+    itsStatistics.numberOfSubscribers_ = numberOfSubscribers_;
+    itsStatistics.listeners_.reserve(numberOfSubscribers_);
+    for (const Subscriber &itsSubscriber : pendingSubscribers_) {
+        if (itsSubscriber.entry_)
+            itsStatistics.listeners_.emplace_back(itsSubscriber.subscription_,
+                                                  itsSubscriber.entry_->latency_.getSnapshot());
+    }
+    return itsStatistics;
+}
+
+template<typename ... Arguments_>
+void Event<Arguments_...>::resetStatistics() {
+    statistics_.reset();
+
+    std::unique_lock<std::mutex> itsSubscriptionLock(lockSubscriptions());
+    for (const Subscriber &itsSubscriber : pendingSubscribers_) {
+        if (itsSubscriber.entry_)
+            itsSubscriber.entry_->latency_.reset();
+    }
+}
+#endif
 
 } // namespace CommonAPI
 
@@ -0,0 +1,233 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#if !defined (COMMONAPI_INTERNAL_COMPILATION)
+#error "Only <CommonAPI/CommonAPI.hpp> can be included directly, this file may disappear or change contents."
+#endif
+
+#ifndef COMMONAPI_EVENT_STATISTICS_HPP_
+#define COMMONAPI_EVENT_STATISTICS_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace CommonAPI {
+
+/**
+ * \brief Copy of the state of a LatencyHistogram.
+ *
+ * All durations are in nanoseconds.
+ */
+struct LatencyHistogramSnapshot {
+    LatencyHistogramSnapshot() : count_(0), sum_(0), max_(0) {}
+
+    /**
+     * \brief Returns the duration that is not exceeded by the given share of samples.
+     *
+     * The result is the lower bound of the bucket the percentile falls into,
+     * thus it may be up to 25% below the exact value.
+     *
+     * @param _percentile The share of samples, from 0.0 to 100.0.
+     */
+    uint64_t getPercentile(double _percentile) const;
+
+    uint64_t getMean() const {
+        return (count_ > 0 ? sum_ / count_ : 0);
+    }
+
+    uint64_t count_;
+    uint64_t sum_;
+    uint64_t max_;
+    std::vector<uint64_t> buckets_;
+};
+
+/**
+ * \brief Histogram of durations that can be recorded into concurrently.
+ *
+ * Buckets are logarithmic with four linear sub-buckets per power of two,
+ * which bounds the relative error to 25% over the whole range of up to
+ * about a minute. Durations beyond are counted in the last bucket.
+ * Recording is wait-free, snapshots are not atomic with respect to
+ * concurrent recordings.
+ */
+class LatencyHistogram {
+public:
+    static const std::size_t SUB_BUCKET_BITS = 2;
+    static const std::size_t SUB_BUCKETS = (1u << SUB_BUCKET_BITS);
+    static const std::size_t MAX_MAGNITUDE = 36; // 2^36ns ~ 68s
+    static const std::size_t NUMBER_OF_BUCKETS = (MAX_MAGNITUDE - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+    LatencyHistogram() {
+        reset();
+    }
+
+    LatencyHistogram(const LatencyHistogram &) = delete;
+    LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+    void record(std::chrono::nanoseconds _duration) {
+        uint64_t itsValue = (_duration.count() > 0 ? static_cast<uint64_t>(_duration.count()) : 0);
+        buckets_[getBucket(itsValue)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(itsValue, std::memory_order_relaxed);
+
+        uint64_t itsMax = max_.load(std::memory_order_relaxed);
+        while (itsValue > itsMax
+               && !max_.compare_exchange_weak(itsMax, itsValue, std::memory_order_relaxed)) {
+        }
+    }
+
+    LatencyHistogramSnapshot getSnapshot() const {
+        LatencyHistogramSnapshot itsSnapshot;
+        itsSnapshot.count_ = count_.load(std::memory_order_relaxed);
+        itsSnapshot.sum_ = sum_.load(std::memory_order_relaxed);
+        itsSnapshot.max_ = max_.load(std::memory_order_relaxed);
+        itsSnapshot.buckets_.reserve(NUMBER_OF_BUCKETS);
+        for (const auto &b : buckets_)
+            itsSnapshot.buckets_.push_back(b.load(std::memory_order_relaxed));
+        return itsSnapshot;
+    }
+
+    void reset() {
+        for (auto &b : buckets_)
+            b.store(0, std::memory_order_relaxed);
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    static std::size_t getBucket(uint64_t _value) {
+        if (_value < SUB_BUCKETS)
+            return static_cast<std::size_t>(_value);
+
+        std::size_t itsMagnitude(0);
+        for (uint64_t v = _value; v > 1; v >>= 1)
+            itsMagnitude++;
+        if (itsMagnitude > MAX_MAGNITUDE)
+            return NUMBER_OF_BUCKETS - 1;
+
+        std::size_t itsSubBucket
+            = static_cast<std::size_t>(_value >> (itsMagnitude - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+        return (itsMagnitude - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + itsSubBucket;
+    }
+
+    static uint64_t getBucketLowerBound(std::size_t _bucket) {
+        if (_bucket < SUB_BUCKETS)
+            return _bucket;
+
+        std::size_t itsMagnitude = _bucket / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+        uint64_t itsSubBucket = (_bucket & (SUB_BUCKETS - 1));
+        return ((SUB_BUCKETS + itsSubBucket) << (itsMagnitude - SUB_BUCKET_BITS));
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, NUMBER_OF_BUCKETS> buckets_;
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> sum_;
+    std::atomic<uint64_t> max_;
+};
+
+inline uint64_t LatencyHistogramSnapshot::getPercentile(double _percentile) const {
+    if (count_ == 0)
+        return 0;
+
+    // Rank of the sample, counting from one
+    double itsRank = (_percentile / 100.0) * static_cast<double>(count_);
+    uint64_t itsThreshold = static_cast<uint64_t>(itsRank);
+    if (static_cast<double>(itsThreshold) < itsRank || itsThreshold == 0)
+        itsThreshold++;
+
+    uint64_t itsCount(0);
+    for (std::size_t i = 0; i < buckets_.size(); i++) {
+        itsCount += buckets_[i];
+        if (itsCount >= itsThreshold)
+            return LatencyHistogram::getBucketLowerBound(i);
+    }
+    return max_;
+}
+
+/**
+ * \brief Records the time from its construction to its destruction.
+ */
+class LatencyScope {
+public:
+    LatencyScope(LatencyHistogram &_histogram)
+        : histogram_(_histogram), start_(std::chrono::steady_clock::now()) {
+    }
+
+    ~LatencyScope() {
+        histogram_.record(std::chrono::steady_clock::now() - start_);
+    }
+
+    LatencyScope(const LatencyScope &) = delete;
+    LatencyScope &operator=(const LatencyScope &) = delete;
+
+private:
+    LatencyHistogram &histogram_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * \brief The counters an Event records into, if built with
+ *        COMMONAPI_ENABLE_EVENT_STATISTICS.
+ */
+struct EventStatisticsRecorder {
+    EventStatisticsRecorder() {
+        reset();
+    }
+
+    void reset() {
+        notifications_.store(0, std::memory_order_relaxed);
+        subscriptions_.store(0, std::memory_order_relaxed);
+        unsubscriptions_.store(0, std::memory_order_relaxed);
+        publications_.store(0, std::memory_order_relaxed);
+        lockWait_.reset();
+        notification_.reset();
+    }
+
+    std::atomic<uint64_t> notifications_;
+    std::atomic<uint64_t> subscriptions_;
+    std::atomic<uint64_t> unsubscriptions_;
+    std::atomic<uint64_t> publications_;
+    LatencyHistogram lockWait_;
+    LatencyHistogram notification_;
+};
+
+/**
+ * \brief Statistics of an Event, as returned by Event::getStatistics.
+ */
+struct EventStatistics {
+    EventStatistics()
+        : notifications_(0), subscriptions_(0), unsubscriptions_(0),
+          publications_(0), numberOfSubscribers_(0) {}
+
+    // Calls of the notification methods
+    uint64_t notifications_;
+
+    // Subscription churn: subscribe and unsubscribe calls (including
+    // cancellations) and publications of a changed subscriber list
+    uint64_t subscriptions_;
+    uint64_t unsubscriptions_;
+    uint64_t publications_;
+    std::size_t numberOfSubscribers_;
+
+    // Time spent waiting for the subscription lock
+    LatencyHistogramSnapshot lockWait_;
+
+    // Time spent in the notification methods, listener calls included,
+    // but without the calls passed to an executor
+    LatencyHistogramSnapshot notification_;
+
+    // Execution time of each listener, by subscription
+    std::vector<std::pair<uint32_t, LatencyHistogramSnapshot>> listeners_;
+};
+
+} // namespace CommonAPI
+
+#endif // COMMONAPI_EVENT_STATISTICS_HPP_
@@ -0,0 +1,88 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#if !defined (COMMONAPI_INTERNAL_COMPILATION)
+#error "Only <CommonAPI/CommonAPI.hpp> can be included directly, this file may disappear or change contents."
+#endif
+
+#ifndef COMMONAPI_EXECUTOR_HPP_
+#define COMMONAPI_EXECUTOR_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <CommonAPI/Export.hpp>
+
+namespace CommonAPI {
+
+/**
+ * \brief Executes tasks on behalf of the runtime.
+ *
+ * An executor may run tasks on any thread, but tasks that are passed with
+ * the same key must be executed one after the other in the order they
+ * were passed.
+ */
+class Executor {
+public:
+    typedef std::function<void()> Task;
+
+    virtual ~Executor() {}
+
+    /**
+     * \brief Schedules a task for execution.
+     *
+     * @param _key Ordering key. Tasks with equal keys are executed sequentially.
+     * @param _task The task to be executed.
+     */
+    virtual void execute(std::size_t _key, Task _task) = 0;
+};
+
+/**
+ * \brief Executor that runs tasks on a fixed number of worker threads.
+ *
+ * Each key is bound to one worker, which guarantees the ordering of tasks
+ * with equal keys while tasks with different keys are spread over all
+ * workers. Pending tasks are executed before the pool is destroyed.
+ * A task may destroy the pool; the worker that runs the task then finishes
+ * its pending tasks after the destructor returned.
+ */
+class COMMONAPI_EXPORT_CLASS_EXPLICIT ThreadPoolExecutor : public Executor {
+public:
+    COMMONAPI_METHOD_EXPORT ThreadPoolExecutor(std::size_t _numberOfThreads = std::thread::hardware_concurrency());
+    COMMONAPI_METHOD_EXPORT virtual ~ThreadPoolExecutor();
+
+    ThreadPoolExecutor(const ThreadPoolExecutor &) = delete;
+    ThreadPoolExecutor &operator=(const ThreadPoolExecutor &) = delete;
+
+    COMMONAPI_METHOD_EXPORT void execute(std::size_t _key, Task _task);
+
+    COMMONAPI_METHOD_EXPORT std::size_t getNumberOfThreads() const;
+
+private:
+    struct Worker {
+        Worker() : isRunning_(true) {}
+
+        std::deque<Task> tasks_;
+        bool isRunning_;
+
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        std::thread thread_;
+    };
+
+    static void run(Worker &_worker);
+
+    std::vector<std::shared_ptr<Worker>> workers_;
+};
+
+} // namespace CommonAPI
+
+#endif // COMMONAPI_EXECUTOR_HPP_
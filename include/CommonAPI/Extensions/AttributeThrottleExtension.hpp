@@ -0,0 +1,253 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef COMMONAPI_EXTENSIONS_ATTRIBUTE_THROTTLE_EXTENSION_HPP_
+#define COMMONAPI_EXTENSIONS_ATTRIBUTE_THROTTLE_EXTENSION_HPP_
+
+#include <CommonAPI/CommonAPI.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace CommonAPI {
+namespace Extensions {
+
+/**
+ * \brief Attribute extension that limits the rate of change notifications
+ *
+ * Listeners subscribed via subscribeThrottled are called at most once per
+ * minimum interval, no matter how often the value of the attribute changes.
+ * A change that arrives within the interval is held back and the listener
+ * is called with the latest held back value once the interval has elapsed
+ * (trailing edge). Held back values are delivered by a Timeout that is
+ * registered with the given main loop context when the first value is held
+ * back, registered again whenever a value is held back after the Timeout was
+ * idle, and deregistered by unsubscribeThrottled or the destructor. Without
+ * a main loop context, or once it was destroyed, changes within the interval
+ * are dropped and the next change after the interval is delivered.
+ *
+ * Lock order: the main loop context is never called with a lock held that
+ * is taken by the listener calls or by the dispatch of the Timeout. The
+ * (de)registrations of a subscription are serialized by a mutex of their
+ * own, which is held while the context calls its listeners. Thus, these
+ * listeners (e.g. those of a MainLoop) must not call unsubscribeThrottled.
+ */
+template<typename AttributeType_>
+class AttributeThrottleExtension : public CommonAPI::AttributeExtension<AttributeType_> {
+    typedef CommonAPI::AttributeExtension<AttributeType_> __baseClass_t;
+
+protected:
+    typedef typename AttributeType_::ValueType value_t;
+    typedef typename AttributeType_::ChangedEvent event_t;
+
+public:
+    typedef typename event_t::Listener Listener;
+    typedef typename event_t::Subscription Subscription;
+
+    AttributeThrottleExtension(AttributeType_& baseAttribute,
+                               std::shared_ptr<MainLoopContext> _mainLoopContext = nullptr)
+            : CommonAPI::AttributeExtension<AttributeType_>(baseAttribute),
+              mainLoopContext_(_mainLoopContext) {
+    }
+
+    ~AttributeThrottleExtension() {
+        std::map<Subscription, std::shared_ptr<Throttle>> itsThrottles;
+        {
+            std::lock_guard<std::mutex> itsLock(throttlesMutex_);
+            itsThrottles.swap(throttles_);
+        }
+        for (auto &t : itsThrottles) {
+            __baseClass_t::getBaseAttribute().getChangedEvent().unsubscribe(t.first);
+            t.second->close();
+        }
+    }
+
+    /**
+     * @brief subscribeThrottled Subscribe a listener to the changed event of the
+     *                           attribute that is called at most once per interval.
+     * @param _listener The listener to be added.
+     * @param _minimumInterval The minimum time between two calls of the listener.
+     * @return The subscription, to be passed to unsubscribeThrottled.
+     */
+    Subscription subscribeThrottled(Listener _listener, std::chrono::milliseconds _minimumInterval) {
+        std::shared_ptr<Throttle> itsThrottle
+            = std::make_shared<Throttle>(std::move(_listener), _minimumInterval.count());
+
+        itsThrottle->mainLoopContext_ = mainLoopContext_;
+
+        Subscription itsSubscription
+            = __baseClass_t::getBaseAttribute().getChangedEvent().subscribe(
+                [itsThrottle](const value_t &_value) {
+                    itsThrottle->onValueUpdate(_value);
+                });
+
+        std::lock_guard<std::mutex> itsLock(throttlesMutex_);
+        throttles_[itsSubscription] = std::move(itsThrottle);
+        return itsSubscription;
+    }
+
+    /**
+     * @brief unsubscribeThrottled Remove a listener that was added by subscribeThrottled.
+     *                             Held back values are not delivered anymore.
+     * @param _subscription The subscription to be removed.
+     */
+    void unsubscribeThrottled(Subscription _subscription) {
+        std::shared_ptr<Throttle> itsThrottle;
+        {
+            std::lock_guard<std::mutex> itsLock(throttlesMutex_);
+            auto it = throttles_.find(_subscription);
+            if (it == throttles_.end())
+                return;
+            itsThrottle = std::move(it->second);
+            throttles_.erase(it);
+        }
+
+        __baseClass_t::getBaseAttribute().getChangedEvent().unsubscribe(_subscription);
+        itsThrottle->close();
+    }
+
+private:
+    struct Throttle : public Timeout {
+        Throttle(Listener _listener, int64_t _interval)
+            : listener_(std::move(_listener)),
+              interval_(_interval),
+              lastDelivery_(0),
+              hasDelivered_(false),
+              isClosed_(false),
+              readyTime_(TIMEOUT_INFINITE),
+              isRegistered_(false) {
+        }
+
+        void onValueUpdate(const value_t &_value) {
+            std::unique_lock<std::mutex> itsLock(mutex_);
+            if (isClosed_)
+                return;
+
+            int64_t now = getCurrentTimeInMs();
+            bool hasContext = !mainLoopContext_.expired();
+            if (!hasContext) {
+                // Nothing delivers held back values (anymore), drop them
+                pending_.reset();
+                readyTime_.store(TIMEOUT_INFINITE, std::memory_order_release);
+            }
+
+            if (!pending_ && (!hasDelivered_ || now - lastDelivery_ >= interval_)) {
+                lastDelivery_ = now;
+                hasDelivered_ = true;
+                itsLock.unlock();
+                listener_(_value);
+                return;
+            }
+
+            if (!hasContext)
+                return;
+
+            bool isScheduled = static_cast<bool>(pending_);
+            pending_ = _value;
+            if (isScheduled)
+                return;
+
+            // The ready time moves from infinite to an earlier point in time,
+            // registering (again) lets the main loop schedule it.
+            readyTime_.store(lastDelivery_ + interval_, std::memory_order_release);
+            itsLock.unlock();
+            updateRegistration();
+        }
+
+        bool dispatch() {
+            std::unique_lock<std::mutex> itsLock(mutex_);
+            if (!pending_ || getCurrentTimeInMs() < readyTime_.load(std::memory_order_acquire))
+                return true;
+
+            // Stays registered, but idle until the next value is held back
+            value_t itsValue(std::move(*pending_));
+            pending_.reset();
+            lastDelivery_ = getCurrentTimeInMs();
+            readyTime_.store(TIMEOUT_INFINITE, std::memory_order_release);
+            itsLock.unlock();
+
+            listener_(itsValue);
+            return true;
+        }
+
+        int64_t getTimeoutInterval() const {
+            return interval_;
+        }
+
+        int64_t getReadyTime() const {
+            return readyTime_.load(std::memory_order_acquire);
+        }
+
+        // Drops the held back value and deregisters the Timeout. The
+        // listener is not called anymore once this method returned,
+        // except for a call that is executing concurrently.
+        void close() {
+            {
+                std::lock_guard<std::mutex> itsLock(mutex_);
+                isClosed_ = true;
+                pending_.reset();
+                readyTime_.store(TIMEOUT_INFINITE, std::memory_order_release);
+            }
+            updateRegistration();
+        }
+
+        // Applies the current state to the context. The state is read after
+        // the registration lock was taken, thus a registration can neither
+        // overtake the deregistration by close nor be lost.
+        void updateRegistration() {
+            std::lock_guard<std::mutex> itsRegistrationLock(registrationMutex_);
+            bool isClosed, isPending;
+            {
+                std::lock_guard<std::mutex> itsLock(mutex_);
+                isClosed = isClosed_;
+                isPending = static_cast<bool>(pending_);
+            }
+
+            std::shared_ptr<MainLoopContext> itsContext = mainLoopContext_.lock();
+            if (!itsContext) {
+                isRegistered_ = false;
+            } else if (isClosed) {
+                if (isRegistered_)
+                    itsContext->deregisterTimeoutSource(this);
+                isRegistered_ = false;
+            } else if (isPending) {
+                itsContext->registerTimeoutSource(this);
+                isRegistered_ = true;
+            }
+        }
+
+        Listener listener_;
+        const int64_t interval_;
+
+        // Guards the values, never held while calling the listener or the context
+        std::mutex mutex_;
+        int64_t lastDelivery_;
+        bool hasDelivered_;
+        bool isClosed_;
+        std::optional<value_t> pending_;
+        std::atomic<int64_t> readyTime_;
+
+        // Serializes the calls to the context, taken before mutex_
+        std::mutex registrationMutex_;
+        bool isRegistered_;
+
+        std::weak_ptr<MainLoopContext> mainLoopContext_;
+    };
+
+    std::weak_ptr<MainLoopContext> mainLoopContext_;
+
+    std::mutex throttlesMutex_;
+    std::map<Subscription, std::shared_ptr<Throttle>> throttles_;
+};
+
+} // namespace Extensions
+} // namespace CommonAPI
+
+#endif // COMMONAPI_EXTENSIONS_ATTRIBUTE_THROTTLE_EXTENSION_HPP_
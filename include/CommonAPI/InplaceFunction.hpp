@@ -0,0 +1,255 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#if !defined (COMMONAPI_INTERNAL_COMPILATION)
+#error "Only <CommonAPI/CommonAPI.hpp> can be included directly, this file may disappear or change contents."
+#endif
+
+#ifndef COMMONAPI_INPLACE_FUNCTION_HPP_
+#define COMMONAPI_INPLACE_FUNCTION_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Size of the buffer an InplaceFunction stores its callable in. Must be
+// the same for all compilation units of an application.
+#ifndef COMMONAPI_INPLACE_FUNCTION_CAPACITY
+#define COMMONAPI_INPLACE_FUNCTION_CAPACITY 48
+#endif
+
+namespace CommonAPI {
+
+template<typename Signature_, std::size_t Capacity_ = COMMONAPI_INPLACE_FUNCTION_CAPACITY>
+class InplaceFunction;
+
+// Callables that may be empty and must then result in an empty function
+template<typename Callable_>
+struct IsNullableCallable
+    : std::integral_constant<bool, std::is_pointer<Callable_>::value
+                                   || std::is_member_pointer<Callable_>::value> {
+};
+
+template<typename Signature_>
+struct IsNullableCallable<std::function<Signature_>> : std::true_type {
+};
+
+template<typename Signature_, std::size_t Capacity_>
+struct IsNullableCallable<InplaceFunction<Signature_, Capacity_>> : std::true_type {
+};
+
+// Callables an InplaceFunction of the given signature can be created from
+template<typename Function_, typename Signature_>
+struct IsInplaceCallable;
+
+template<typename Function_, typename Result_, typename... Arguments_>
+struct IsInplaceCallable<Function_, Result_(Arguments_...)>
+    : std::is_invocable_r<Result_, typename std::decay<Function_>::type &, Arguments_...> {
+};
+
+/**
+ * \brief Move-only polymorphic function wrapper with inline storage
+ *
+ * Replacement for std::function that stores callables of up to Capacity_
+ * bytes (e.g. lambdas capturing a few pointers or a shared_ptr, bound member
+ * functions or a std::function) inside the object itself. Creating, moving
+ * and calling such an InplaceFunction never allocates. Larger callables and
+ * callables that cannot be moved without throwing are stored on the heap.
+ * As an InplaceFunction cannot be copied, it may also store callables that
+ * are move-only themselves.
+ */
+template<typename Result_, typename... Arguments_, std::size_t Capacity_>
+class InplaceFunction<Result_(Arguments_...), Capacity_> {
+public:
+    InplaceFunction() noexcept
+        : invoke_(nullptr), manage_(nullptr) {
+    }
+
+    InplaceFunction(std::nullptr_t) noexcept
+        : invoke_(nullptr), manage_(nullptr) {
+    }
+
+    template<typename Function_,
+             typename Callable_ = typename std::decay<Function_>::type,
+             typename = typename std::enable_if<
+                 !std::is_same<Callable_, InplaceFunction>::value
+                 && std::is_invocable_r<Result_, Callable_ &, Arguments_...>::value
+             >::type>
+    InplaceFunction(Function_ &&_function)
+        : invoke_(nullptr), manage_(nullptr) {
+        if (isEmpty<Callable_>(_function))
+            return;
+
+        if constexpr (isStoredInplace<Callable_>()) {
+            ::new (static_cast<void *>(&storage_)) Callable_(std::forward<Function_>(_function));
+            invoke_ = &invokeInplace<Callable_>;
+            manage_ = &manageInplace<Callable_>;
+        } else {
+            Callable_ *itsCallable = new Callable_(std::forward<Function_>(_function));
+            ::new (static_cast<void *>(&storage_)) Callable_ *(itsCallable);
+            invoke_ = &invokeAllocated<Callable_>;
+            manage_ = &manageAllocated<Callable_>;
+        }
+    }
+
+    InplaceFunction(const InplaceFunction &) = delete;
+
+    InplaceFunction(InplaceFunction &&_other) noexcept
+        : invoke_(nullptr), manage_(nullptr) {
+        moveFrom(_other);
+    }
+
+    ~InplaceFunction() {
+        reset();
+    }
+
+    InplaceFunction &operator=(const InplaceFunction &) = delete;
+
+    InplaceFunction &operator=(InplaceFunction &&_other) noexcept {
+        if (this != &_other) {
+            reset();
+            moveFrom(_other);
+        }
+        return *this;
+    }
+
+    InplaceFunction &operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    template<typename Function_,
+             typename Callable_ = typename std::decay<Function_>::type,
+             typename = typename std::enable_if<
+                 !std::is_same<Callable_, InplaceFunction>::value
+                 && std::is_invocable_r<Result_, Callable_ &, Arguments_...>::value
+             >::type>
+    InplaceFunction &operator=(Function_ &&_function) {
+        InplaceFunction itsFunction(std::forward<Function_>(_function));
+        reset();
+        moveFrom(itsFunction);
+        return *this;
+    }
+
+    explicit operator bool() const noexcept {
+        return (invoke_ != nullptr);
+    }
+
+    Result_ operator()(Arguments_... _arguments) const {
+        if (!invoke_)
+            throw std::bad_function_call();
+        return invoke_(const_cast<Storage *>(&storage_), std::forward<Arguments_>(_arguments)...);
+    }
+
+    friend bool operator==(const InplaceFunction &_function, std::nullptr_t) noexcept {
+        return !_function;
+    }
+    friend bool operator==(std::nullptr_t, const InplaceFunction &_function) noexcept {
+        return !_function;
+    }
+    friend bool operator!=(const InplaceFunction &_function, std::nullptr_t) noexcept {
+        return static_cast<bool>(_function);
+    }
+    friend bool operator!=(std::nullptr_t, const InplaceFunction &_function) noexcept {
+        return static_cast<bool>(_function);
+    }
+
+private:
+    struct Storage {
+        alignas(std::max_align_t) unsigned char data_[Capacity_];
+    };
+
+    enum class Operation {
+        MOVE,
+        DESTROY
+    };
+
+    typedef Result_ (*Invoker)(Storage *, Arguments_&&...);
+    typedef void (*Manager)(Operation, Storage *, Storage *);
+
+    template<typename Callable_>
+    static constexpr bool isStoredInplace() {
+        return (sizeof(Callable_) <= sizeof(Storage)
+                && alignof(Callable_) <= alignof(Storage)
+                && std::is_nothrow_move_constructible<Callable_>::value);
+    }
+
+    template<typename Function_>
+    static bool isEmpty(const Function_ &_function) {
+        if constexpr (IsNullableCallable<Function_>::value) {
+            return !static_cast<bool>(_function);
+        } else {
+            (void)_function;
+            return false;
+        }
+    }
+
+    template<typename Callable_>
+    static Result_ invokeInplace(Storage *_storage, Arguments_&&... _arguments) {
+        return std::invoke(*std::launder(reinterpret_cast<Callable_ *>(_storage)),
+                           std::forward<Arguments_>(_arguments)...);
+    }
+
+    template<typename Callable_>
+    static Result_ invokeAllocated(Storage *_storage, Arguments_&&... _arguments) {
+        return std::invoke(**std::launder(reinterpret_cast<Callable_ **>(_storage)),
+                           std::forward<Arguments_>(_arguments)...);
+    }
+
+    template<typename Callable_>
+    static void manageInplace(Operation _operation, Storage *_target, Storage *_source) {
+        Callable_ *itsSource = std::launder(reinterpret_cast<Callable_ *>(_source));
+        switch (_operation) {
+        case Operation::MOVE:
+            ::new (static_cast<void *>(_target)) Callable_(std::move(*itsSource));
+            itsSource->~Callable_();
+            break;
+        case Operation::DESTROY:
+            itsSource->~Callable_();
+            break;
+        }
+    }
+
+    template<typename Callable_>
+    static void manageAllocated(Operation _operation, Storage *_target, Storage *_source) {
+        Callable_ *itsSource = *std::launder(reinterpret_cast<Callable_ **>(_source));
+        switch (_operation) {
+        case Operation::MOVE:
+            ::new (static_cast<void *>(_target)) Callable_ *(itsSource);
+            break;
+        case Operation::DESTROY:
+            delete itsSource;
+            break;
+        }
+    }
+
+    void moveFrom(InplaceFunction &_other) noexcept {
+        if (_other.manage_) {
+            _other.manage_(Operation::MOVE, &storage_, &_other.storage_);
+            invoke_ = _other.invoke_;
+            manage_ = _other.manage_;
+            _other.invoke_ = nullptr;
+            _other.manage_ = nullptr;
+        }
+    }
+
+    void reset() noexcept {
+        if (manage_) {
+            manage_(Operation::DESTROY, &storage_, &storage_);
+            invoke_ = nullptr;
+            manage_ = nullptr;
+        }
+    }
+
+    Storage storage_;
+    Invoker invoke_;
+    Manager manage_;
+};
+
+} // namespace CommonAPI
+
+#endif // COMMONAPI_INPLACE_FUNCTION_HPP_
@@ -0,0 +1,112 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#if !defined (COMMONAPI_INTERNAL_COMPILATION)
+#error "Only <CommonAPI/CommonAPI.hpp> can be included directly, this file may disappear or change contents."
+#endif
+
+#ifndef COMMONAPI_INTERNEDADDRESS_HPP_
+#define COMMONAPI_INTERNEDADDRESS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+
+#include <CommonAPI/Address.hpp>
+#include <CommonAPI/Export.hpp>
+
+namespace CommonAPI {
+
+/**
+ * \brief Interned representation of an Address.
+ *
+ * Domains, interfaces and instances are interned in a process wide table
+ * and identified by 32-bit ids. An InternedAddress only refers to the
+ * immutable table entry of its address, which also holds the hash, the
+ * canonical string and the Address itself. Thus, copying, comparing and
+ * hashing an InternedAddress as well as converting it to an Address or a
+ * string take constant time. Only creating an InternedAddress looks up the
+ * table. Interned addresses are never released.
+ *
+ * The order of interned addresses is the order of their ids, which is not
+ * lexicographic, but stable for the lifetime of the process.
+ */
+class COMMONAPI_EXPORT_CLASS_EXPLICIT InternedAddress {
+public:
+    COMMONAPI_METHOD_EXPORT InternedAddress();
+    COMMONAPI_METHOD_EXPORT InternedAddress(const Address &_address);
+    COMMONAPI_METHOD_EXPORT explicit InternedAddress(const std::string &_address);
+    COMMONAPI_METHOD_EXPORT InternedAddress(const std::string &_domain,
+            const std::string &_interface,
+            const std::string &_instance);
+
+    inline bool operator==(const InternedAddress &_other) const {
+        return entry_ == _other.entry_;
+    }
+
+    inline bool operator!=(const InternedAddress &_other) const {
+        return entry_ != _other.entry_;
+    }
+
+    inline bool operator<(const InternedAddress &_other) const {
+        if (entry_->domain_ != _other.entry_->domain_)
+            return entry_->domain_ < _other.entry_->domain_;
+        if (entry_->interface_ != _other.entry_->interface_)
+            return entry_->interface_ < _other.entry_->interface_;
+        return entry_->instance_ < _other.entry_->instance_;
+    }
+
+    inline operator const Address &() const { return entry_->address_; }
+
+    /**
+     * \brief Returns the canonical string "domain:interface:instance".
+     */
+    inline const std::string &getAddress() const { return entry_->string_; }
+
+    inline const std::string &getDomain() const { return entry_->address_.getDomain(); }
+    inline const std::string &getInterface() const { return entry_->address_.getInterface(); }
+    inline const std::string &getInstance() const { return entry_->address_.getInstance(); }
+
+    inline uint32_t getDomainId() const { return entry_->domain_; }
+    inline uint32_t getInterfaceId() const { return entry_->interface_; }
+    inline uint32_t getInstanceId() const { return entry_->instance_; }
+
+    inline std::size_t getHash() const { return entry_->hash_; }
+
+private:
+    class Table;
+
+    struct Entry {
+        uint32_t domain_;
+        uint32_t interface_;
+        uint32_t instance_;
+        std::size_t hash_;
+        Address address_;
+        std::string string_;
+    };
+
+    static const Entry *intern(const Address &_address);
+
+    const Entry *entry_;
+
+    friend COMMONAPI_EXPORT std::ostream &operator<<(std::ostream &_out, const InternedAddress &_address);
+};
+
+} // namespace CommonAPI
+
+namespace std {
+
+template<>
+struct hash<CommonAPI::InternedAddress> {
+    std::size_t operator()(const CommonAPI::InternedAddress &_address) const {
+        return _address.getHash();
+    }
+};
+
+} // namespace std
+
+#endif // COMMONAPI_INTERNEDADDRESS_HPP_
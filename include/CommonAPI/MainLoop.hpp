@@ -0,0 +1,298 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#if !defined (COMMONAPI_INTERNAL_COMPILATION)
+#error "Only <CommonAPI/CommonAPI.hpp> can be included directly, this file may disappear or change contents."
+#endif
+
+#ifndef COMMONAPI_MAINLOOP_HPP_
+#define COMMONAPI_MAINLOOP_HPP_
+
+#ifdef __linux__
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <CommonAPI/EventStatistics.hpp>
+#include <CommonAPI/Export.hpp>
+#include <CommonAPI/MainLoopContext.hpp>
+#include <CommonAPI/TimeoutScheduler.hpp>
+
+namespace CommonAPI {
+
+/**
+ * \brief Spin statistics of a MainLoop, as returned by MainLoop::getSpinStatistics.
+ */
+struct MainLoopSpinStatistics {
+    MainLoopSpinStatistics() : spins_(0), hits_(0), budget_(0) {}
+
+    // Spin phases, and those that found a ready element before the budget was used up
+    uint64_t spins_;
+    uint64_t hits_;
+
+    // Current spin budget in nanoseconds
+    int64_t budget_;
+
+    // Duration of the spin phases
+    LatencyHistogramSnapshot spinTime_;
+
+    // Time from the first wakeup signaled to the loop until the loop resumed
+    LatencyHistogramSnapshot wakeLatency_;
+};
+
+/**
+ * \brief Reference main loop for a MainLoopContext (Linux only).
+ *
+ * The main loop subscribes to all hooks of the given context and dispatches
+ * the registered Watches, Timeouts and DispatchSources. File descriptors are
+ * monitored by epoll and only modified on (de)registration, thus waiting for
+ * and reacting on a ready file descriptor does not depend on the number of
+ * registered watches. Wakeup events are signaled by an eventfd, Timeouts by
+ * a timerfd armed with the earliest ready time.
+ *
+ * If built with COMMONAPI_ENABLE_IO_URING, file descriptors are monitored by
+ * io_uring poll requests instead, if supported by the kernel (5.13 or newer) and
+ * not overridden by setting the environment variable COMMONAPI_MAINLOOP_POLLER to "epoll".
+ * Requests of watches are one-shot and re-armed once the watches of the file
+ * descriptor were dispatched, the eventfd and timerfd are monitored by
+ * multishot requests. All requests queued by an iteration are submitted
+ * together with the wait for completions by a single system call. The loop enables wakeup
+ * coalescing of the context while it exists, thus a burst of wakeups between two iterations
+ * signals the eventfd only once.
+ *
+ * Timeouts are kept in a hierarchical timing wheel, thus (de)registering and
+ * expiring them does not depend on the number of registered timeouts. A
+ * Timeout is scheduled for its ready time on registration and after each
+ * dispatch, registering a known Timeout again reschedules it. A ready time
+ * that was moved to a later point in time, or an interval that became
+ * infinite, is detected on expiry. A Timeout whose ready time moves to an
+ * earlier point in time, or whose interval is no longer infinite, must be
+ * registered again. For Timeouts that do not, polling can be enabled by
+ * setTimeoutPolling: the loop then checks all Timeouts in each iteration,
+ * which makes an iteration depend on the number of Timeouts.
+ *
+ * Optionally, the loop spins before it blocks: for a bounded time, it polls
+ * the file descriptors without waiting and checks the prepared DispatchSources
+ * and the Timeouts in a tight loop. This avoids the latency of sleeping and
+ * waking up at the cost of CPU time. The spin budget adapts to the observed
+ * time between ready events: twice the average, but at most the configured
+ * maximum. If events arrive less frequently than the maximum, the loop
+ * blocks immediately.
+ *
+ * Ready elements are dispatched in the order of their DispatchPriority.
+ * Within a priority, Timeouts are dispatched before Watches and Watches
+ * before DispatchSources. The ready DispatchSources of a priority are
+ * dispatched round-robin, starting with a different source in each
+ * iteration. BudgetedDispatchSources are dispatched by deficit round-robin.
+ *
+ * Elements may be (de)registered from any thread and from within dispatch
+ * callbacks. The loop itself must be run by a single thread.
+ *
+ * By default, the elements are dispatched by the thread that runs the loop.
+ * If a number of dispatch threads is given, they are dispatched by a pool of
+ * worker threads instead and the loop thread only waits for and distributes
+ * ready elements. Each element is dispatched by at most one worker at a time
+ * and is not prepared, checked or polled while it is dispatched. Workers take
+ * queued elements by priority, so a ready element of a higher priority is
+ * dispatched before queued elements of lower priorities. Idle workers steal
+ * queued elements from busy ones. Different elements, even if registered by
+ * the same binding, may be dispatched concurrently.
+ */
+class COMMONAPI_EXPORT_CLASS_EXPLICIT MainLoop {
+public:
+    COMMONAPI_METHOD_EXPORT MainLoop(std::shared_ptr<MainLoopContext> _context,
+                                     std::size_t _numberOfDispatchThreads = 0);
+    COMMONAPI_METHOD_EXPORT ~MainLoop();
+
+    MainLoop(const MainLoop &) = delete;
+    MainLoop &operator=(const MainLoop &) = delete;
+
+    /**
+     * \brief Runs the main loop until stop is called.
+     */
+    COMMONAPI_METHOD_EXPORT void run();
+
+    /**
+     * \brief Stops the main loop. May be called from any thread.
+     */
+    COMMONAPI_METHOD_EXPORT void stop();
+
+    /**
+     * \brief Runs a single iteration of the main loop.
+     *
+     * Waits until at least one element is ready to be dispatched, the
+     * loop is woken up or the given timeout expired, and dispatches all
+     * elements that are ready. With dispatch threads, the ready elements
+     * are passed to the workers and the method returns immediately.
+     *
+     * @param _timeout Maximum time to wait in milliseconds.
+     * @return 'true' if at least one element was dispatched (or passed to the workers).
+     */
+    COMMONAPI_METHOD_EXPORT bool iterate(int64_t _timeout = TIMEOUT_INFINITE);
+
+    /**
+     * \brief Interrupts a waiting iteration. May be called from any thread.
+     */
+    COMMONAPI_METHOD_EXPORT void wakeup();
+
+    COMMONAPI_METHOD_EXPORT bool isRunning() const;
+
+    /**
+     * \brief Sets the maximum spin budget. May be called from any thread.
+     *
+     * @param _maximum Upper bound of the adaptive spin budget, zero
+     *                 disables spinning (default).
+     */
+    COMMONAPI_METHOD_EXPORT void setSpinBudget(std::chrono::microseconds _maximum);
+
+    COMMONAPI_METHOD_EXPORT MainLoopSpinStatistics getSpinStatistics() const;
+
+    /**
+     * \brief Enables or disables polling the ready times of the Timeouts.
+     * May be called from any thread.
+     *
+     * @param _isEnabled 'true' if there are Timeouts that do not register again
+     *                   when their ready time moves to an earlier point in time
+     *                   or their interval stops being infinite. Disabled by default.
+     */
+    COMMONAPI_METHOD_EXPORT void setTimeoutPolling(bool _isEnabled);
+
+private:
+    static const std::size_t NUMBER_OF_PRIORITIES = static_cast<std::size_t>(DispatchPriority::VERY_LOW) + 1;
+
+    class WorkerPool;
+    class Poller;
+    class EpollPoller;
+    class UringPoller;
+
+    // A file descriptor reported ready by the poller
+    struct PollEvent {
+        int fd_;
+        uint32_t events_;
+    };
+
+    // Entries are shared with the list of ready elements of the current
+    // iteration. A deregistered entry is marked inactive and skipped.
+    // Timeouts and sources are busy while they are queued for or dispatched
+    // by a worker, watches are covered by their one-shot descriptor.
+    typedef ScheduledTimeout TimeoutEntry;
+
+    struct WatchEntry {
+        WatchEntry(Watch *_watch, DispatchPriority _priority, int _fd, short _events)
+            : watch_(_watch), priority_(_priority), fd_(_fd), events_(_events), isActive_(true) {}
+
+        Watch *watch_;
+        DispatchPriority priority_;
+        int fd_;
+        short events_;
+        std::atomic<bool> isActive_;
+    };
+
+    struct SourceEntry {
+        SourceEntry(DispatchSource *_source, DispatchPriority _priority)
+            : source_(_source), budgeted_(dynamic_cast<BudgetedDispatchSource *>(_source)),
+              priority_(_priority), isActive_(true), isBusy_(false), deficit_(0) {}
+
+        DispatchSource *source_;
+        BudgetedDispatchSource *budgeted_;
+        DispatchPriority priority_;
+        std::atomic<bool> isActive_;
+        std::atomic<bool> isBusy_;
+
+        // Units a budgeted source may dispatch in addition to its next quantum
+        std::size_t deficit_;
+    };
+
+    // All watches of a file descriptor share a single poller registration.
+    // With dispatch threads or a poller without level triggered monitoring,
+    // the registration is one-shot and re-armed once all watches of the
+    // descriptor were dispatched (pending_).
+    struct Descriptor {
+        Descriptor() : events_(0), isRegistered_(false), pending_(0) {}
+
+        uint32_t events_;
+        bool isRegistered_;
+        std::size_t pending_;
+        std::vector<std::shared_ptr<WatchEntry>> watches_;
+    };
+
+    typedef CommonAPI::ReadyList<WatchEntry, SourceEntry> ReadyList;
+
+    void registerWatch(Watch *_watch, const DispatchPriority _priority);
+    void deregisterWatch(Watch *_watch);
+    void registerTimeout(Timeout *_timeout, const DispatchPriority _priority);
+    void deregisterTimeout(Timeout *_timeout);
+    void rescheduleTimeouts();
+    void registerSource(DispatchSource *_source, const DispatchPriority _priority);
+    void deregisterSource(DispatchSource *_source);
+
+    void updateDescriptor(int _fd, Descriptor &_descriptor, bool _rearm = false);
+    void releaseDescriptor(int _fd);
+    void armTimer(int64_t _readyTime);
+    static void drain(int _fd);
+
+    bool prepareSources(ReadyList *_ready, std::vector<std::shared_ptr<SourceEntry>> &_unready,
+                        int64_t &_timeout);
+    int spin(PollEvent *_events, int _maxEvents,
+             const std::vector<std::shared_ptr<SourceEntry>> &_unready,
+             int64_t _readyTime, int64_t _timeout, bool &_isReady);
+    void adaptSpinBudget(int64_t _now);
+    int64_t getNextReadyTime();
+    void collectTimeouts(ReadyList *_ready);
+    void collectWatches(const int _fd, const uint32_t _events, ReadyList *_ready);
+    std::size_t dispatch(ReadyList *_ready);
+    void dispatchTimeout(const std::shared_ptr<TimeoutEntry> &_entry);
+    void dispatchWatch(WatchEntry &_entry, unsigned int _events);
+    void dispatchSource(SourceEntry &_entry);
+
+    std::shared_ptr<MainLoopContext> context_;
+    DispatchSourceListenerSubscription sourceSubscription_;
+    WatchListenerSubscription watchSubscription_;
+    TimeoutSourceListenerSubscription timeoutSubscription_;
+    WakeupListenerSubscription wakeupSubscription_;
+
+    std::unique_ptr<Poller> poller_;
+    bool isOneShot_;
+    int wakeupFd_;
+    int timerFd_;
+    int64_t armedTime_;
+
+    std::atomic<bool> isRunning_;
+
+    // Spinning, the budgets in nanoseconds
+    std::atomic<int64_t> maximumSpinBudget_;
+    std::atomic<int64_t> spinBudget_;
+    int64_t lastReadyTime_;
+    int64_t averageReadyInterval_;
+    std::atomic<uint64_t> spins_;
+    std::atomic<uint64_t> spinHits_;
+    LatencyHistogram spinTime_;
+    std::atomic<int64_t> wakeupTime_;
+    LatencyHistogram wakeLatency_;
+
+    std::unique_ptr<WorkerPool> workerPool_;
+
+    // Source of each priority to be dispatched first in the next iteration
+    std::size_t rotation_[NUMBER_OF_PRIORITIES];
+
+    // Guards the registered elements
+    std::mutex mutex_;
+    std::unordered_map<int, Descriptor> descriptors_;
+    std::map<Watch *, int> watches_;
+    TimeoutScheduler timeouts_;
+    std::map<DispatchSource *, std::shared_ptr<SourceEntry>> sources_;
+};
+
+} // namespace CommonAPI
+
+#endif // __linux__
+
+#endif // COMMONAPI_MAINLOOP_HPP_
@@ -22,13 +22,18 @@
 #undef max
 #endif
 
+#include <atomic>
 #include <limits>
 #include <vector>
 #include <chrono>
 #include <list>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 
+#include <CommonAPI/AtomicSnapshot.hpp>
+#include <CommonAPI/EventStatistics.hpp>
 #include <CommonAPI/Export.hpp>
 
 namespace CommonAPI {
@@ -42,7 +47,88 @@ enum class DispatchPriority {
 };
 
 
+/**
+ * \brief Source of the time returned by getCurrentTimeInMs and its variants.
+ *
+ * The default clock is std::chrono::steady_clock. Another clock, e.g. a
+ * SimulatedClock, may be installed by setClock. Main loops that wait for
+ * timeouts by other means than the clock, like the timerfd of MainLoop,
+ * do not follow a replaced clock.
+ */
+class Clock {
+public:
+    virtual ~Clock() {}
+
+    virtual int64_t getCurrentTimeInNs() const = 0;
+};
+
+/**
+ * \brief Replaces the clock of the process, nullptr restores the default clock.
+ *
+ * Must not be called while other threads read the time.
+ */
+void COMMONAPI_EXPORT setClock(std::shared_ptr<Clock> _clock);
+
 int64_t COMMONAPI_EXPORT getCurrentTimeInMs();
+int64_t COMMONAPI_EXPORT getCurrentTimeInUs();
+int64_t COMMONAPI_EXPORT getCurrentTimeInNs();
+
+
+/**
+ * \brief Statistics of an element registered with an instrumented MainLoopContext.
+ */
+struct DispatchStatistics {
+    enum class Kind {
+        DISPATCH_SOURCE,
+        WATCH,
+        TIMEOUT
+    };
+
+    DispatchStatistics()
+        : element_(nullptr), kind_(Kind::DISPATCH_SOURCE), priority_(DispatchPriority::DEFAULT),
+          dispatches_(0), moreToDispatch_(0) {}
+
+    // The registered DispatchSource, Watch or Timeout
+    const void *element_;
+    Kind kind_;
+    DispatchPriority priority_;
+
+    // Calls of dispatch, and those of DispatchSources that returned 'true'
+    uint64_t dispatches_;
+    uint64_t moreToDispatch_;
+
+    // Execution time of dispatch
+    LatencyHistogramSnapshot duration_;
+};
+
+/**
+ * \brief Statistics of a DispatchPriority of an instrumented MainLoopContext.
+ */
+struct DispatchPriorityStatistics {
+    DispatchPriorityStatistics() : backlog_(0), maxBacklog_(0) {}
+
+    // Time from the point an element became ready to its dispatch. DispatchSources
+    // become ready when prepare or check returns 'true', Timeouts at their ready
+    // time. Watches are not covered.
+    LatencyHistogramSnapshot starvation_;
+
+    // DispatchSources that are ready, but not yet dispatched: current and maximum
+    std::size_t backlog_;
+    std::size_t maxBacklog_;
+};
+
+/**
+ * \brief Statistics of an instrumented MainLoopContext.
+ */
+struct MainLoopStatistics {
+    std::string name_;
+
+    // The currently registered elements
+    std::vector<DispatchStatistics> elements_;
+
+    // Indexed by DispatchPriority
+    std::vector<DispatchPriorityStatistics> priorities_;
+};
 
 
 /**
@@ -82,6 +168,46 @@ struct DispatchSource {
 };
 
 
+/**
+ * \brief Describes a DispatchSource whose work can be dispatched in portions.
+ *
+ * The work of the source is divided into units, e.g. messages. Main loops that
+ * know this interface bound the units dispatched per call, thus a source with a
+ * lot of pending work does not delay the sources of the same priority. The
+ * reference MainLoop shares the dispatch calls of a priority between its ready
+ * sources by deficit round-robin: each ready source gets its quantum per round,
+ * unused units of a source that has more to dispatch are carried over to the
+ * next round. Main loops that do not know this interface call dispatch(),
+ * which dispatches all pending work.
+ */
+struct BudgetedDispatchSource : public DispatchSource {
+    static const std::size_t DEFAULT_QUANTUM = 64;
+
+    virtual ~BudgetedDispatchSource() {}
+
+    /**
+     * \brief Dispatches at most the given number of units.
+     *
+     * @param _budget The maximum number of units to be dispatched.
+     * @param _consumed The number of units that were dispatched.
+     * @return 'true' if there currently is more to dispatch, 'false' if not.
+     */
+    virtual bool dispatchWithBudget(std::size_t _budget, std::size_t &_consumed) = 0;
+
+    /**
+     * \brief The number of units the source may dispatch per round.
+     */
+    virtual std::size_t getDispatchQuantum() const {
+        return DEFAULT_QUANTUM;
+    }
+
+    bool dispatch() {
+        std::size_t itsConsumed(0);
+        return dispatchWithBudget(std::numeric_limits<std::size_t>::max(), itsConsumed);
+    }
+};
+
+
 /**
  * \brief Describes an element that manages a file descriptor.
  *
@@ -166,7 +292,8 @@ struct Timeout {
      *
      * After a initialization and after each dispatch, this timeout will re-calculate it's next
      * ready time. This value may be ignored if a different mechanism for monitoring timeout intervals
-     * is used.
+     * is used. If the ready time moves to an earlier point in time at any other time, the timeout
+     * must be registered again to let the main loop reschedule it.
      */
     virtual int64_t getReadyTime() const = 0;
 };
@@ -197,11 +324,23 @@ typedef WakeupListenerList::iterator WakeupListenerSubscription;
  * By registering callbacks with this class, you will be notified about all DispatchSources,
  * Watches, Timeouts and Wakeup-Events that need to be handled by your Main Loop implementation.
  *
+ * All methods may be called concurrently from any thread. The listener lists are guarded by a
+ * mutex, but notifications do not take it: each change of a list publishes an immutable copy
+ * that is swapped in and read by the notifying threads without locks (see AtomicSnapshot).
+ * Thus, wakeup and the (de)registration methods neither take the mutex nor allocate. A copy
+ * is released by the last notification that uses it. Listeners are called without any lock
+ * held and may (un)subscribe. Unsubscribing waits until the calls of the removed listener
+ * by other threads have returned, calls by the unsubscribing thread itself (i.e. a listener
+ * that unsubscribes itself) are not waited for. Thus, two listeners must not unsubscribe
+ * each other concurrently.
  */
 class COMMONAPI_EXPORT_CLASS_EXPLICIT MainLoopContext {
 public:
     COMMONAPI_METHOD_EXPORT MainLoopContext(const std::string &_name = "COMMONAPI_DEFAULT_MAINLOOP_CONTEXT")
-        : name_(_name){
+        : name_(_name),
+          wakeupCoalescers_(0),
+          isWakeupPending_(false),
+          suppressedWakeups_(0) {
     }
 
     COMMONAPI_METHOD_EXPORT MainLoopContext(const MainLoopContext&) = delete;
@@ -283,9 +422,61 @@ public:
 
     /**
      * \brief Notifies all listeners about a wakeup event that just happened.
+     *
+     * With wakeup coalescing enabled, only the first wakeup after the last
+     * acknowledgement is passed to the listeners, all further ones are
+     * suppressed until the main loop acknowledges again.
      */
     COMMONAPI_METHOD_EXPORT void wakeup();
 
+    /**
+     * \brief Enables or disables wakeup coalescing.
+     *
+     * Must only be enabled by a main loop that calls acknowledgeWakeup
+     * each time it woke up, before it checks for ready elements. Otherwise,
+     * wakeups get lost. Coalescing assumes a single main loop per context.
+     *
+     * Enabling and disabling are counted: coalescing stays enabled until
+     * each call that enabled it is matched by a call that disables it.
+     * Disabling it more often than it was enabled has no effect.
+     */
+    COMMONAPI_METHOD_EXPORT void setWakeupCoalescing(bool _isEnabled);
+
+    /**
+     * \brief Re-enables wakeup notifications suppressed by coalescing.
+     *
+     * To be called by the main loop after it woke up and before it checks
+     * the registered elements, thus a wakeup that happens while the
+     * elements are checked or dispatched wakes up the next iteration.
+     */
+    COMMONAPI_METHOD_EXPORT void acknowledgeWakeup();
+
+    /**
+     * \brief Returns the number of wakeups that were suppressed by coalescing.
+     */
+    COMMONAPI_METHOD_EXPORT uint64_t getSuppressedWakeups() const;
+
+    /**
+     * \brief Enables instrumentation of the elements registered from now on.
+     *
+     * Instrumented DispatchSources, Watches and Timeouts are passed to the
+     * listeners wrapped into proxies that record the dispatch durations and
+     * counts, the starvation time and the backlog. Cannot be disabled.
+     */
+    COMMONAPI_METHOD_EXPORT void enableInstrumentation();
+
+    /**
+     * \brief Returns the statistics of the instrumented elements.
+     *
+     * @return 'false' if the instrumentation is not enabled.
+     */
+    COMMONAPI_METHOD_EXPORT bool getStatistics(MainLoopStatistics &_statistics) const;
+
+    /**
+     * \brief Returns the statistics of all instrumented contexts with the given name.
+     */
+    COMMONAPI_METHOD_EXPORT static std::vector<MainLoopStatistics> getStatistics(const std::string &_name);
+
     /**
      * \brief Will return true if at least one subscribe for DispatchSources or Watches has been called.
      *
@@ -295,12 +486,56 @@ public:
     COMMONAPI_METHOD_EXPORT bool isInitialized();
 
  private:
+    class Instrumentation;
+
+    // A listener as referenced by the published lists. Its calls are
+    // counted, thus unsubscribing can wait for calls in progress.
+    template<typename Listener_>
+    struct ListenerEntry {
+        ListenerEntry(const Listener_ &_listener)
+            : subscription_(&_listener), listener_(_listener), isActive_(true), calls_(0) {}
+
+        const Listener_ *subscription_; // element of the listener list
+        const Listener_ listener_;
+        std::atomic<bool> isActive_;
+        std::atomic<std::size_t> calls_;
+    };
+
+    template<typename Listener_>
+    using Snapshot = AtomicSnapshot<std::vector<std::shared_ptr<ListenerEntry<Listener_>>>>;
+
+    template<typename Listener_>
+    static void addListener(const Listener_ &_listener, Snapshot<Listener_> &_snapshot);
+    template<typename Listener_>
+    static std::shared_ptr<ListenerEntry<Listener_>> removeListener(const Listener_ &_listener,
+                                                                   Snapshot<Listener_> &_snapshot);
+    template<typename Listener_>
+    static void waitForCalls(const ListenerEntry<Listener_> &_entry);
+    template<typename Listener_, typename Function_>
+    static void notify(const Snapshot<Listener_> &_snapshot, Function_ _function);
+
+    std::shared_ptr<Instrumentation> getInstrumentation() const;
+
+    // Guards the listener lists and the changes of the snapshots
+    std::mutex listenersMutex_;
     DispatchSourceListenerList dispatchSourceListeners_;
     WatchListenerList watchListeners_;
     TimeoutSourceListenerList timeoutSourceListeners_;
     WakeupListenerList wakeupListeners_;
 
+    Snapshot<DispatchSourceListenerList::value_type> dispatchSourceSnapshot_;
+    Snapshot<WatchListenerList::value_type> watchSnapshot_;
+    Snapshot<TimeoutSourceListenerList::value_type> timeoutSourceSnapshot_;
+    Snapshot<WakeupListenerList::value_type> wakeupSnapshot_;
+
     std::string name_;
+
+    // Number of main loops that enabled wakeup coalescing
+    std::atomic<uint32_t> wakeupCoalescers_;
+    std::atomic<bool> isWakeupPending_;
+    std::atomic<uint64_t> suppressedWakeups_;
+
+    AtomicSnapshot<std::shared_ptr<Instrumentation>> instrumentation_;
 };
 
 } // namespace CommonAPI
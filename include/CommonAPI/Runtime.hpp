@@ -10,12 +10,20 @@
 #ifndef COMMONAPI_RUNTIME_HPP_
 #define COMMONAPI_RUNTIME_HPP_
 
+#include <atomic>
+#include <functional>
+#include <future>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
 
+#include <CommonAPI/AtomicSnapshot.hpp>
 #include <CommonAPI/AttributeExtension.hpp>
+#include <CommonAPI/Executor.hpp>
 #include <CommonAPI/Export.hpp>
 #include <CommonAPI/Factory.hpp>
 #include <CommonAPI/Types.hpp>
@@ -29,8 +37,34 @@ class Proxy;
 class ProxyManager;
 class StubBase;
 
-class COMMONAPI_EXPORT_CLASS_EXPLICIT Runtime {
+/**
+ * \brief A proxy to be built by Runtime::buildProxiesAsync.
+ *
+ * The proxy is created for the given main loop context if set, otherwise
+ * for the given connection.
+ */
+struct ProxyRequest {
+    ProxyRequest(const std::string &_domain, const std::string &_interface, const std::string &_instance,
+                 const ConnectionId_t &_connectionId = DEFAULT_CONNECTION_ID)
+        : domain_(_domain), interface_(_interface), instance_(_instance),
+          connectionId_(_connectionId) {}
+
+    ProxyRequest(const std::string &_domain, const std::string &_interface, const std::string &_instance,
+                 std::shared_ptr<MainLoopContext> _context)
+        : domain_(_domain), interface_(_interface), instance_(_instance),
+          context_(_context) {}
+
+    std::string domain_;
+    std::string interface_;
+    std::string instance_;
+    ConnectionId_t connectionId_;
+    std::shared_ptr<MainLoopContext> context_;
+};
+
+class COMMONAPI_EXPORT_CLASS_EXPLICIT Runtime : public std::enable_shared_from_this<Runtime> {
 public:
+    typedef std::function<void(const std::vector<std::shared_ptr<Proxy>> &)> ProxiesBuiltCallback;
+
     COMMONAPI_METHOD_EXPORT static std::string getProperty(const std::string &_name);
     COMMONAPI_METHOD_EXPORT static void setProperty(const std::string &_name, const std::string &_value);
 
@@ -76,6 +110,79 @@ public:
         return nullptr;
     }
 
+    /**
+     * \brief Builds a proxy asynchronously.
+     *
+     * The proxy is built by the given executor or, if none is given, by
+     * the thread pool of the runtime. The runtime is kept alive until the
+     * proxy was built, thus it must be owned by a std::shared_ptr, like
+     * the one returned by get().
+     *
+     * @return Future of the proxy, which is empty if it could not be built.
+     */
+    template<template<typename ...> class ProxyClass_, typename ... AttributeExtensions_>
+    COMMONAPI_METHOD_EXPORT std::future<std::shared_ptr<
+        ProxyClass_<AttributeExtensions_...>
+    >>
+    buildProxyAsync(const std::string &_domain,
+                    const std::string &_instance,
+                    const ConnectionId_t &_connectionId = DEFAULT_CONNECTION_ID,
+                    std::shared_ptr<Executor> _executor = nullptr) {
+        auto itsPromise = std::make_shared<std::promise<std::shared_ptr<ProxyClass_<AttributeExtensions_...>>>>();
+        auto itsFuture = itsPromise->get_future();
+        execute(_executor, [itsRuntime = shared_from_this(), itsPromise, _domain, _instance, _connectionId]() {
+            try {
+                itsPromise->set_value(itsRuntime->buildProxy<ProxyClass_, AttributeExtensions_...>(
+                    _domain, _instance, _connectionId));
+            } catch (...) {
+                itsPromise->set_exception(std::current_exception());
+            }
+        });
+        return itsFuture;
+    }
+
+    template<template<typename ...> class ProxyClass_, typename ... AttributeExtensions_>
+    COMMONAPI_METHOD_EXPORT std::future<std::shared_ptr<
+        ProxyClass_<AttributeExtensions_...>
+    >>
+    buildProxyAsync(const std::string &_domain,
+                    const std::string &_instance,
+                    std::shared_ptr<MainLoopContext> _context,
+                    std::shared_ptr<Executor> _executor = nullptr) {
+        auto itsPromise = std::make_shared<std::promise<std::shared_ptr<ProxyClass_<AttributeExtensions_...>>>>();
+        auto itsFuture = itsPromise->get_future();
+        execute(_executor, [itsRuntime = shared_from_this(), itsPromise, _domain, _instance, _context]() {
+            try {
+                itsPromise->set_value(itsRuntime->buildProxy<ProxyClass_, AttributeExtensions_...>(
+                    _domain, _instance, _context));
+            } catch (...) {
+                itsPromise->set_exception(std::current_exception());
+            }
+        });
+        return itsFuture;
+    }
+
+    /**
+     * \brief Builds a batch of proxies concurrently.
+     *
+     * The factories are initialized once for the batch, then all proxies are
+     * created in parallel by the given executor or, if none is given, by the
+     * thread pool of the runtime. A binding library needed by several proxies
+     * is loaded only once. The created proxies are generic and are wrapped by
+     * their proxy class, e.g. std::make_shared<MyProxy<>>(proxy). Like by
+     * buildProxyAsync, the runtime is kept alive until all proxies were built.
+     *
+     * @param _requests The proxies to be built.
+     * @param _callback Optional callback, called once all proxies were built,
+     *                  with the proxies in the order of the requests.
+     * @return Futures of the proxies in the order of the requests. A future is
+     *         empty if its proxy could not be built.
+     */
+    COMMONAPI_METHOD_EXPORT std::vector<std::future<std::shared_ptr<Proxy>>>
+    buildProxiesAsync(const std::vector<ProxyRequest> &_requests,
+                      ProxiesBuiltCallback _callback = nullptr,
+                      std::shared_ptr<Executor> _executor = nullptr);
+
     template <template<typename ...> class ProxyClass_, template<typename> class AttributeExtension_>
     COMMONAPI_METHOD_EXPORT std::shared_ptr<typename DefaultAttributeProxyHelper<ProxyClass_, AttributeExtension_>::class_t>
     buildProxyWithDefaultAttributeExtension(const std::string &_domain,
@@ -138,7 +245,61 @@ public:
     COMMONAPI_METHOD_EXPORT void initFactories();
     COMMONAPI_METHOD_EXPORT Timeout_t getDefaultCallTimeout() const;
 
+    /**
+     * \brief Loads the configured binding libraries in the background.
+     *
+     * Loads the libraries of all proxy and stub mappings of the configuration
+     * in parallel, thus the first proxy or stub of an interface does not pay
+     * for loading its library. The libraries are loaded by a pool of at most
+     * four threads, which is released once all libraries were loaded. The
+     * runtime is kept alive until then. Done on
+     * initialization, if the section "default" of the configuration contains
+     * "preload=true" (lazy symbol binding) or "preload=now" (immediate symbol
+     * binding).
+     *
+     * @param _isImmediate Resolve all symbols when loading a library instead
+     *                     of on their first use (RTLD_NOW, ignored on Windows).
+     * @return Future that is ready once all libraries were loaded.
+     */
+    COMMONAPI_METHOD_EXPORT std::shared_future<void> preloadLibraries(bool _isImmediate = false);
+
+    /**
+     * \brief Waits until the libraries of the latest preload were loaded.
+     */
+    COMMONAPI_METHOD_EXPORT void waitForPreload();
+
 private:
+    // Resolution of the address of a proxy or stub to its binding library
+    // and to the factory that created it last. Immutable, an update
+    // replaces the resolution.
+    struct Resolution {
+        std::size_t hash_;
+        std::string domain_;
+        std::string interface_;
+        std::string instance_;
+        bool isProxy_;
+        std::string library_;
+        bool isLoaded_;
+        std::shared_ptr<Factory> factory_;
+    };
+
+    // Immutable snapshot of the registered factories. Registering or
+    // unregistering a factory publishes a new snapshot, thus proxies and
+    // stubs are created without holding a lock while the factory runs.
+    // The resolutions are filled lazily and are only valid for the
+    // factories of their snapshot.
+    struct Factories {
+        Factories() {}
+        Factories(const Factories &_other)
+            : factories_(_other.factories_), defaultFactory_(_other.defaultFactory_) {}
+
+        std::map<std::string, std::shared_ptr<Factory>> factories_;
+        std::shared_ptr<Factory> defaultFactory_;
+
+        mutable std::shared_mutex resolutionsMutex_;
+        mutable std::unordered_multimap<std::size_t, std::shared_ptr<const Resolution>> resolutions_;
+    };
+
     COMMONAPI_METHOD_EXPORT void init();
     COMMONAPI_METHOD_EXPORT bool readConfiguration();
     COMMONAPI_METHOD_EXPORT bool splitAddress(const std::string &, std::string &, std::string &, std::string &);
@@ -148,25 +309,30 @@ private:
     COMMONAPI_METHOD_EXPORT std::shared_ptr<Proxy> createProxy(const std::string &, const std::string &, const std::string &,
                                        std::shared_ptr<MainLoopContext>);
 
-    COMMONAPI_METHOD_EXPORT std::shared_ptr<Proxy> createProxyHelper(const std::string &, const std::string &, const std::string &,
-                                             const ConnectionId_t &, bool);
-    COMMONAPI_METHOD_EXPORT std::shared_ptr<Proxy> createProxyHelper(const std::string &, const std::string &, const std::string &,
-                                             std::shared_ptr<MainLoopContext>, bool);
-
 
     COMMONAPI_METHOD_EXPORT bool registerStub(const std::string &, const std::string &, const std::string &,
                       std::shared_ptr<StubBase>, const ConnectionId_t &);
     COMMONAPI_METHOD_EXPORT bool registerStub(const std::string &, const std::string &, const std::string &,
                       std::shared_ptr<StubBase>, std::shared_ptr<MainLoopContext>);
-    COMMONAPI_METHOD_EXPORT bool registerStubHelper(const std::string &, const std::string &, const std::string &,
-                            std::shared_ptr<StubBase>, const ConnectionId_t &, bool);
-    COMMONAPI_METHOD_EXPORT bool registerStubHelper(const std::string &, const std::string &, const std::string &,
-                            std::shared_ptr<StubBase>, std::shared_ptr<MainLoopContext>, bool);
 
     COMMONAPI_METHOD_EXPORT bool unregisterStub(const std::string &, const std::string &, const std::string &);
 
     COMMONAPI_METHOD_EXPORT std::string getLibrary(const std::string &, const std::string &, const std::string &, bool);
-    COMMONAPI_METHOD_EXPORT bool loadLibrary(const std::string &);
+    COMMONAPI_METHOD_EXPORT bool loadLibrary(const std::string &, bool _isImmediate = false);
+
+    std::shared_ptr<const Factories> getFactories() const;
+    void setFactories(std::shared_ptr<const Factories> _factories);
+
+    template<typename Result_, typename Create_>
+    Result_ create(const std::string &_domain, const std::string &_interface, const std::string &_instance,
+                   bool _isProxy, Create_ _create);
+    std::shared_ptr<const Resolution> resolve(const Factories &_factories,
+                                              const std::string &_domain, const std::string &_interface,
+                                              const std::string &_instance, bool _isProxy);
+    void remember(const Factories &_factories, const std::shared_ptr<const Resolution> &_resolution,
+                  std::shared_ptr<Factory> _factory, bool _isLoaded);
+
+    COMMONAPI_METHOD_EXPORT void execute(std::shared_ptr<Executor> _executor, Executor::Task _task);
 
 private:
     std::string usedConfig_;
@@ -176,20 +342,30 @@ private:
     std::string defaultConfig_;
     Timeout_t defaultCallTimeout_;
 
-    std::map<std::string, std::shared_ptr<Factory>> factories_;
-    std::shared_ptr<Factory> defaultFactory_;
+    AtomicSnapshot<std::shared_ptr<const Factories>> factories_;
     std::map<std::string, std::map<bool, std::string>> libraries_;
     std::set<std::string> loadedLibraries_; // Library name
 
     std::mutex mutex_;
-    std::mutex factoriesMutex_;
-    std::mutex loadMutex_;
+    std::mutex factoriesMutex_; // Serializes modifications of factories_
+    std::mutex loadMutex_; // Guards loadedLibraries_
 
     bool isConfigured_;
-    bool isInitialized_;
+    std::atomic<bool> isInitialized_;
+
+    // Preload of the configured libraries on initialization
+    bool isPreloading_;
+    bool isPreloadImmediate_;
 
     static std::map<std::string, std::string> properties_;
 
+    // Builds proxies asynchronously if no executor is given. Declared last,
+    // as pending builds are finished before it is destroyed.
+    std::mutex executorMutex_;
+    std::shared_future<void> preload_;
+    std::unique_ptr<ThreadPoolExecutor> executor_;
+    std::atomic<std::size_t> nextKey_;
+
 friend class ProxyManager;
 };
 
@@ -0,0 +1,182 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#if !defined (COMMONAPI_INTERNAL_COMPILATION)
+#error "Only <CommonAPI/CommonAPI.hpp> can be included directly, this file may disappear or change contents."
+#endif
+
+#ifndef COMMONAPI_SIMULATEDMAINLOOP_HPP_
+#define COMMONAPI_SIMULATEDMAINLOOP_HPP_
+
+#ifndef _WIN32
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <CommonAPI/Export.hpp>
+#include <CommonAPI/MainLoopContext.hpp>
+#include <CommonAPI/TimeoutScheduler.hpp>
+
+namespace CommonAPI {
+
+/**
+ * \brief Clock that only advances when told to.
+ */
+class SimulatedClock : public Clock {
+public:
+    SimulatedClock(int64_t _startTimeInMs = 0)
+        : now_(_startTimeInMs * 1000000) {
+    }
+
+    int64_t getCurrentTimeInNs() const {
+        return now_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * \brief Sets the time, which never goes backwards.
+     */
+    void setCurrentTimeInNs(int64_t _now) {
+        int64_t itsNow = now_.load(std::memory_order_relaxed);
+        while (_now > itsNow
+               && !now_.compare_exchange_weak(itsNow, _now, std::memory_order_acq_rel)) {
+        }
+    }
+
+    void advance(std::chrono::nanoseconds _duration) {
+        setCurrentTimeInNs(getCurrentTimeInNs() + _duration.count());
+    }
+
+private:
+    std::atomic<int64_t> now_;
+};
+
+/**
+ * \brief A dispatch of a SimulatedMainLoop, at simulated time.
+ */
+struct SimulatedDispatch {
+    int64_t time_; // ns
+    DispatchStatistics::Kind kind_;
+    const void *element_;
+};
+
+/**
+ * \brief Main loop for a MainLoopContext that runs in simulated time.
+ *
+ * Intended for tests and benchmarks of timeout heavy behaviour. The loop
+ * never waits: it dispatches everything that is ready at the current
+ * simulated time and then advances the time of the given clock to the
+ * next Timeout that is due. Thus, hours of timeouts are replayed within
+ * milliseconds. The clock must be installed by setClock, so that Timeouts
+ * calculate their ready times in simulated time.
+ *
+ * Watches are polled without waiting, file descriptors that become ready
+ * by themselves are only noticed at the next dispatch or time step. Ready
+ * elements are dispatched in the order of their DispatchPriority, like by
+ * MainLoop. Each dispatch is recorded with its simulated time, if tracing
+ * is enabled.
+ *
+ * Elements may be (de)registered from any thread, the loop must be run by
+ * a single thread.
+ */
+class COMMONAPI_EXPORT_CLASS_EXPLICIT SimulatedMainLoop {
+public:
+    /**
+     * \brief Runs the elements of the context in the simulated time of the clock.
+     *
+     * @throws std::invalid_argument if the context or the clock is missing.
+     */
+    COMMONAPI_METHOD_EXPORT SimulatedMainLoop(std::shared_ptr<MainLoopContext> _context,
+                                              std::shared_ptr<SimulatedClock> _clock);
+    COMMONAPI_METHOD_EXPORT ~SimulatedMainLoop();
+
+    SimulatedMainLoop(const SimulatedMainLoop &) = delete;
+    SimulatedMainLoop &operator=(const SimulatedMainLoop &) = delete;
+
+    /**
+     * \brief Dispatches the ready elements until none is ready at the current time.
+     *
+     * Stops after 1000 rounds, as a source that is always ready would never
+     * let the simulated time advance.
+     *
+     * @return The number of dispatches.
+     */
+    COMMONAPI_METHOD_EXPORT std::size_t runPending();
+
+    /**
+     * \brief Runs the loop until the simulated time reached the given point in time.
+     *
+     * The time advances by at least a millisecond per step, thus a Timeout
+     * that is still due after its dispatch is dispatched once per millisecond.
+     *
+     * @param _time The point in time in milliseconds.
+     * @return The number of dispatches.
+     */
+    COMMONAPI_METHOD_EXPORT std::size_t runUntil(int64_t _time);
+
+    /**
+     * \brief Runs the loop for the given duration of simulated time.
+     */
+    COMMONAPI_METHOD_EXPORT std::size_t runFor(std::chrono::milliseconds _duration);
+
+    /**
+     * \brief Enables or disables polling the ready times of the Timeouts.
+     *
+     * Like MainLoop, the loop expects Timeouts to register again when they
+     * become due earlier. If polling is enabled, the loop checks all Timeouts
+     * in each round instead, which makes a round depend on the number of
+     * Timeouts. Disabled by default.
+     */
+    COMMONAPI_METHOD_EXPORT void setTimeoutPolling(bool _isEnabled);
+
+    COMMONAPI_METHOD_EXPORT void setTracing(bool _isEnabled);
+    COMMONAPI_METHOD_EXPORT std::vector<SimulatedDispatch> getTrace() const;
+    COMMONAPI_METHOD_EXPORT void clearTrace();
+
+private:
+    static const std::size_t NUMBER_OF_PRIORITIES = static_cast<std::size_t>(DispatchPriority::VERY_LOW) + 1;
+    static const std::size_t MAX_ROUNDS = 1000;
+
+    struct Entry {
+        Entry(void *_element, DispatchPriority _priority)
+            : element_(_element), priority_(_priority), isActive_(true) {}
+
+        void *element_;
+        DispatchPriority priority_;
+        std::atomic<bool> isActive_;
+    };
+
+    typedef CommonAPI::ReadyList<Entry, Entry> ReadyList;
+
+    void deregisterTimeout(Timeout *_timeout);
+    bool collect(ReadyList *_ready);
+    std::size_t dispatch(ReadyList *_ready);
+    void trace(DispatchStatistics::Kind _kind, const void *_element);
+
+    std::shared_ptr<MainLoopContext> context_;
+    std::shared_ptr<SimulatedClock> clock_;
+    DispatchSourceListenerSubscription sourceSubscription_;
+    WatchListenerSubscription watchSubscription_;
+    TimeoutSourceListenerSubscription timeoutSubscription_;
+
+    // Guards the registered elements and the trace
+    mutable std::mutex mutex_;
+    std::map<DispatchSource *, std::shared_ptr<Entry>> sources_;
+    std::map<Watch *, std::shared_ptr<Entry>> watches_;
+    TimeoutScheduler timeouts_;
+
+    bool isTracing_;
+    std::vector<SimulatedDispatch> trace_;
+};
+
+} // namespace CommonAPI
+
+#endif // !_WIN32
+
+#endif // COMMONAPI_SIMULATEDMAINLOOP_HPP_
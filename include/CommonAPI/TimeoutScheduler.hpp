@@ -0,0 +1,179 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#if !defined (COMMONAPI_INTERNAL_COMPILATION)
+#error "Only <CommonAPI/CommonAPI.hpp> can be included directly, this file may disappear or change contents."
+#endif
+
+#ifndef COMMONAPI_TIMEOUTSCHEDULER_HPP_
+#define COMMONAPI_TIMEOUTSCHEDULER_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <CommonAPI/MainLoopContext.hpp>
+#include <CommonAPI/TimingWheel.hpp>
+
+namespace CommonAPI {
+
+/**
+ * \brief A Timeout registered with a main loop.
+ *
+ * Entries are shared with the list of ready elements of the current
+ * iteration. A deregistered entry is marked inactive and skipped. A busy
+ * entry is queued for or dispatched by a worker and not scheduled until
+ * its dispatch finished.
+ */
+struct ScheduledTimeout {
+    ScheduledTimeout(Timeout *_timeout, DispatchPriority _priority)
+        : timeout_(_timeout), priority_(_priority), isActive_(true), isBusy_(false),
+          readyTime_(TIMEOUT_INFINITE) {}
+
+    Timeout *timeout_;
+    DispatchPriority priority_;
+    std::atomic<bool> isActive_;
+    std::atomic<bool> isBusy_;
+    TimingWheel<std::shared_ptr<ScheduledTimeout>>::Timer timer_;
+    int64_t readyTime_; // scheduled, TIMEOUT_INFINITE if not
+};
+
+/**
+ * \brief The elements of a DispatchPriority that are ready in an iteration of a main loop.
+ */
+template<typename WatchEntry_, typename SourceEntry_>
+struct ReadyList {
+    struct Watch {
+        std::shared_ptr<WatchEntry_> entry_;
+        unsigned int events_;
+    };
+
+    std::vector<std::shared_ptr<ScheduledTimeout>> timeouts_;
+    std::vector<Watch> watches_;
+    std::vector<std::shared_ptr<SourceEntry_>> sources_;
+};
+
+/**
+ * \brief Schedules the registered Timeouts of a main loop by a timing wheel.
+ *
+ * A Timeout is scheduled for its ready time on registration and after each
+ * dispatch, registering a known Timeout again reschedules it. A ready time
+ * that was moved to a later point in time, or an interval that became
+ * infinite, is detected on expiry. Timeouts that become due earlier without
+ * registering again are only found if polling is enabled.
+ *
+ * Not thread-safe, except for (en|dis)abling the polling.
+ */
+class TimeoutScheduler {
+public:
+    TimeoutScheduler(int64_t _now)
+        : wheel_(_now), isPolling_(false) {
+    }
+
+    TimeoutScheduler(const TimeoutScheduler &) = delete;
+    TimeoutScheduler &operator=(const TimeoutScheduler &) = delete;
+
+    void setPolling(bool _isEnabled) {
+        isPolling_ = _isEnabled;
+    }
+
+    bool isPolling() const {
+        return isPolling_;
+    }
+
+    /**
+     * \brief Adds a Timeout, or reschedules it if it is already known.
+     */
+    void add(Timeout *_timeout, DispatchPriority _priority) {
+        std::shared_ptr<ScheduledTimeout> &itsEntry = timeouts_[_timeout];
+        if (!itsEntry)
+            itsEntry = std::make_shared<ScheduledTimeout>(_timeout, _priority);
+        schedule(itsEntry);
+    }
+
+    /**
+     * \brief Removes a Timeout and marks its entry inactive.
+     */
+    void remove(Timeout *_timeout) {
+        auto itsTimeout = timeouts_.find(_timeout);
+        if (itsTimeout != timeouts_.end()) {
+            itsTimeout->second->isActive_ = false;
+            wheel_.cancel(itsTimeout->second->timer_);
+            timeouts_.erase(itsTimeout);
+        }
+    }
+
+    /**
+     * \brief Reschedules the Timeouts whose ready time moved to an earlier
+     * point in time, if polling is enabled.
+     */
+    void poll() {
+        if (!isPolling_)
+            return;
+
+        for (auto &t : timeouts_) {
+            if (!t.second->isBusy_ && getReadyTime(*t.first) < t.second->readyTime_)
+                schedule(t.second);
+        }
+    }
+
+    /**
+     * \brief Calls the given function for each Timeout that is due at the given point in time.
+     *
+     * Timeouts whose ready time moved to a later point in time are rescheduled.
+     */
+    template<typename Function_>
+    void collect(int64_t _now, Function_ _ready) {
+        wheel_.advance(_now, [this, _now, &_ready](const std::shared_ptr<ScheduledTimeout> &_entry) {
+            if (getReadyTime(*_entry->timeout_) > _now) {
+                schedule(_entry);
+                return;
+            }
+            _ready(_entry);
+        });
+    }
+
+    /**
+     * \brief Schedules a dispatched Timeout again, unless it was removed meanwhile.
+     */
+    void reschedule(const std::shared_ptr<ScheduledTimeout> &_entry) {
+        _entry->isBusy_ = false;
+        if (_entry->isActive_)
+            schedule(_entry);
+    }
+
+    int64_t getNextReadyTime() const {
+        return wheel_.getNextReadyTime();
+    }
+
+    static int64_t getReadyTime(const Timeout &_timeout) {
+        if (_timeout.getTimeoutInterval() == TIMEOUT_INFINITE)
+            return TIMEOUT_INFINITE;
+        return _timeout.getReadyTime();
+    }
+
+private:
+    void schedule(const std::shared_ptr<ScheduledTimeout> &_entry) {
+        // Busy timeouts are scheduled once they were dispatched
+        if (_entry->isBusy_)
+            return;
+
+        _entry->readyTime_ = getReadyTime(*_entry->timeout_);
+        if (_entry->readyTime_ != TIMEOUT_INFINITE)
+            wheel_.schedule(_entry->timer_, _entry, _entry->readyTime_);
+        else
+            wheel_.cancel(_entry->timer_);
+    }
+
+    std::map<Timeout *, std::shared_ptr<ScheduledTimeout>> timeouts_;
+    TimingWheel<std::shared_ptr<ScheduledTimeout>> wheel_;
+    std::atomic<bool> isPolling_;
+};
+
+} // namespace CommonAPI
+
+#endif // COMMONAPI_TIMEOUTSCHEDULER_HPP_
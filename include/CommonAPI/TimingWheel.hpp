@@ -0,0 +1,223 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#if !defined (COMMONAPI_INTERNAL_COMPILATION)
+#error "Only <CommonAPI/CommonAPI.hpp> can be included directly, this file may disappear or change contents."
+#endif
+
+#ifndef COMMONAPI_TIMINGWHEEL_HPP_
+#define COMMONAPI_TIMINGWHEEL_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <limits>
+
+namespace CommonAPI {
+
+/**
+ * \brief Hierarchical timing wheel with a resolution of one millisecond.
+ *
+ * Elements are scheduled for an absolute point in time (in milliseconds,
+ * see getCurrentTimeInMs) and passed to a callback once the wheel has been
+ * advanced beyond that point in time. Scheduling and cancelling take
+ * constant time, independent of the number of scheduled elements.
+ *
+ * The wheel consists of four levels of 256 slots each. Level 0 holds the
+ * elements of the next 256ms, one slot per millisecond. Each further level
+ * covers a 256 times longer period with a 256 times coarser slot, up to
+ * about 49 days. Elements that are scheduled further ahead are parked in
+ * the last level and rescheduled as time passes. Whenever the lower level
+ * wraps around, the elements of the next slot of the upper level are
+ * distributed to the lower levels (cascading). Thus, each element is moved
+ * at most once per level.
+ *
+ * The wheel is not thread-safe.
+ */
+template<typename Element_>
+class TimingWheel {
+    struct Node;
+
+public:
+    /**
+     * \brief Handle of a scheduled element.
+     *
+     * Owned by the scheduling party. Must not be moved or destroyed
+     * while the element is scheduled.
+     */
+    class Timer {
+    public:
+        Timer() : slot_(nullptr) {}
+
+        Timer(const Timer &) = delete;
+        Timer &operator=(const Timer &) = delete;
+
+        bool isScheduled() const {
+            return (slot_ != nullptr);
+        }
+
+    private:
+        friend class TimingWheel;
+
+        std::list<Node> *slot_;
+        typename std::list<Node>::iterator position_;
+    };
+
+    TimingWheel(int64_t _now)
+        : now_(_now), size_(0) {
+    }
+
+    TimingWheel(const TimingWheel &) = delete;
+    TimingWheel &operator=(const TimingWheel &) = delete;
+
+    /**
+     * \brief Schedules an element, replacing an earlier schedule of the timer.
+     *
+     * Elements scheduled for the past expire with the next call of advance.
+     */
+    void schedule(Timer &_timer, Element_ _element, int64_t _readyTime) {
+        cancel(_timer);
+        std::list<Node> &itsSlot = getSlot(_readyTime);
+        itsSlot.push_back({ std::move(_element), _readyTime, &_timer });
+        _timer.slot_ = &itsSlot;
+        _timer.position_ = std::prev(itsSlot.end());
+        size_++;
+    }
+
+    /**
+     * \brief Removes a scheduled element. Does nothing if it is not scheduled.
+     */
+    void cancel(Timer &_timer) {
+        if (_timer.slot_) {
+            _timer.slot_->erase(_timer.position_);
+            _timer.slot_ = nullptr;
+            size_--;
+        }
+    }
+
+    /**
+     * \brief Advances the wheel up to the given point in time (inclusive).
+     *
+     * Calls the given function for each element whose point in time was
+     * reached. The timer of an expired element is not scheduled anymore
+     * when the function is called, thus the function may schedule it again.
+     * Periods without due elements are skipped.
+     */
+    template<typename Function_>
+    void advance(int64_t _now, Function_ _expire) {
+        while (now_ <= _now) {
+            int64_t itsNext = getNextReadyTime();
+            if (itsNext > _now) {
+                now_ = _now + 1;
+                break;
+            }
+            now_ = std::max(now_, itsNext);
+
+            cascade();
+
+            // Expire the whole slot at once, callbacks may schedule again
+            std::list<Node> itsExpired;
+            itsExpired.splice(itsExpired.end(), levels_[0][getIndex(now_, 0)]);
+            size_ -= itsExpired.size();
+            now_++;
+
+            for (Node &n : itsExpired)
+                n.timer_->slot_ = nullptr;
+            for (Node &n : itsExpired)
+                _expire(n.element_);
+        }
+    }
+
+    /**
+     * \brief Returns the earliest point in time an element may expire.
+     *
+     * Exact for elements due within the next 256ms, a lower bound for
+     * elements scheduled further ahead. TIMEOUT_INFINITE (max int64_t)
+     * if no element is scheduled.
+     */
+    int64_t getNextReadyTime() const {
+        int64_t itsNext(std::numeric_limits<int64_t>::max());
+        if (size_ == 0)
+            return itsNext;
+
+        for (std::size_t l = 0; l < LEVELS; l++) {
+            std::size_t itsShift = l * LEVEL_BITS;
+            int64_t itsPeriod = (now_ >> itsShift);
+            bool isAligned = ((now_ & ((int64_t(1) << itsShift) - 1)) == 0);
+
+            // The current slot of a higher level was already cascaded,
+            // unless the current time is the start of the slot.
+            for (std::size_t i = (isAligned ? 0 : 1); i <= SLOTS; i++) {
+                if (i == SLOTS && isAligned)
+                    break;
+                int64_t itsSlotPeriod = itsPeriod + static_cast<int64_t>(i);
+                if (!levels_[l][static_cast<std::size_t>(itsSlotPeriod) & (SLOTS - 1)].empty()) {
+                    itsNext = std::min(itsNext, std::max(now_, itsSlotPeriod << itsShift));
+                    break;
+                }
+            }
+        }
+        return itsNext;
+    }
+
+    std::size_t size() const {
+        return size_;
+    }
+
+private:
+    static const std::size_t LEVEL_BITS = 8;
+    static const std::size_t SLOTS = (std::size_t(1) << LEVEL_BITS);
+    static const std::size_t LEVELS = 4;
+
+    struct Node {
+        Element_ element_;
+        int64_t readyTime_;
+        Timer *timer_;
+    };
+
+    static std::size_t getIndex(int64_t _time, std::size_t _level) {
+        return static_cast<std::size_t>(_time >> (_level * LEVEL_BITS)) & (SLOTS - 1);
+    }
+
+    std::list<Node> &getSlot(int64_t _readyTime) {
+        int64_t itsReadyTime = std::max(_readyTime, now_);
+        for (std::size_t l = 0; l < LEVELS; l++) {
+            if (itsReadyTime - now_ < (int64_t(1) << ((l + 1) * LEVEL_BITS)))
+                return levels_[l][getIndex(itsReadyTime, l)];
+        }
+
+        // Parked in the farthest slot, rescheduled when cascaded
+        int64_t itsParkTime = now_ + (int64_t(1) << (LEVELS * LEVEL_BITS)) - 1;
+        return levels_[LEVELS - 1][getIndex(itsParkTime, LEVELS - 1)];
+    }
+
+    // Distributes the upper level slots that start at now_
+    void cascade() {
+        std::size_t l(1);
+        while (l < LEVELS && (now_ & ((int64_t(1) << (l * LEVEL_BITS)) - 1)) == 0)
+            l++;
+
+        for (std::size_t i = l - 1; i >= 1; i--) {
+            std::list<Node> itsNodes;
+            itsNodes.splice(itsNodes.end(), levels_[i][getIndex(now_, i)]);
+            while (!itsNodes.empty()) {
+                std::list<Node> &itsSlot = getSlot(itsNodes.front().readyTime_);
+                itsSlot.splice(itsSlot.end(), itsNodes, itsNodes.begin());
+                Timer *itsTimer = itsSlot.back().timer_;
+                itsTimer->slot_ = &itsSlot;
+                itsTimer->position_ = std::prev(itsSlot.end());
+            }
+        }
+    }
+
+    int64_t now_; // next point in time to be processed
+    std::size_t size_;
+    std::list<Node> levels_[LEVELS][SLOTS];
+};
+
+} // namespace CommonAPI
+
+#endif // COMMONAPI_TIMINGWHEEL_HPP_
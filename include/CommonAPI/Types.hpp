@@ -20,7 +20,7 @@
 #include <sys/types.h>
 #endif
 
-// define CallStatus before including Event.hpp
+// define CallStatus and SubscriptionStatus before including Event.hpp
 namespace CommonAPI {
     enum class CallStatus {
         SUCCESS,
@@ -33,6 +33,11 @@ namespace CommonAPI {
         SUBSCRIPTION_REFUSED,
         SERIALIZATION_ERROR
     };
+
+    enum class SubscriptionStatus {
+        RETAIN,
+        CANCEL
+    };
 } // namespace CommonAPI
 
 
@@ -0,0 +1,93 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstdint>
+#include <exception>
+
+#include <CommonAPI/Executor.hpp>
+#include <CommonAPI/Logger.hpp>
+
+namespace CommonAPI {
+
+ThreadPoolExecutor::ThreadPoolExecutor(std::size_t _numberOfThreads) {
+    if (_numberOfThreads == 0)
+        _numberOfThreads = 1;
+
+    for (std::size_t i = 0; i < _numberOfThreads; i++)
+        workers_.push_back(std::make_shared<Worker>());
+
+    // Each thread shares its worker, as the thread outlives the
+    // executor if a task destroys the executor.
+    for (auto &w : workers_) {
+        std::shared_ptr<Worker> itsWorker(w);
+        w->thread_ = std::thread([itsWorker]() { run(*itsWorker); });
+    }
+}
+
+ThreadPoolExecutor::~ThreadPoolExecutor() {
+    for (auto &w : workers_) {
+        std::lock_guard<std::mutex> itsLock(w->mutex_);
+        w->isRunning_ = false;
+        w->condition_.notify_one();
+    }
+
+    for (auto &w : workers_) {
+        if (w->thread_.joinable()) {
+            if (w->thread_.get_id() == std::this_thread::get_id()) {
+                // Destroyed by a task. The worker finishes its remaining
+                // tasks and is released by its thread.
+                w->thread_.detach();
+            } else {
+                w->thread_.join();
+            }
+        }
+    }
+}
+
+void
+ThreadPoolExecutor::execute(std::size_t _key, Task _task) {
+    // Keys are often addresses or sequence numbers, scramble them
+    // before mapping them to a worker.
+    std::uint64_t itsHash = static_cast<std::uint64_t>(_key) * 0x9E3779B97F4A7C15ULL;
+    Worker &itsWorker = *workers_[static_cast<std::size_t>((itsHash >> 32) % workers_.size())];
+
+    std::lock_guard<std::mutex> itsLock(itsWorker.mutex_);
+    itsWorker.tasks_.push_back(std::move(_task));
+    itsWorker.condition_.notify_one();
+}
+
+std::size_t
+ThreadPoolExecutor::getNumberOfThreads() const {
+    return workers_.size();
+}
+
+void
+ThreadPoolExecutor::run(Worker &_worker) {
+    std::unique_lock<std::mutex> itsLock(_worker.mutex_);
+    while (true) {
+        _worker.condition_.wait(itsLock, [&_worker]() {
+            return (!_worker.isRunning_ || !_worker.tasks_.empty());
+        });
+
+        if (_worker.tasks_.empty())
+            break; // stopped and drained
+
+        Task itsTask = std::move(_worker.tasks_.front());
+        _worker.tasks_.pop_front();
+
+        itsLock.unlock();
+        try {
+            itsTask();
+        } catch (const std::exception &e) {
+            COMMONAPI_ERROR("ThreadPoolExecutor: task threw exception: ", e.what());
+        }
+        // The task may hold the last reference to the executor,
+        // whose destruction locks the worker.
+        itsTask = nullptr;
+        itsLock.lock();
+    }
+}
+
+} // namespace CommonAPI
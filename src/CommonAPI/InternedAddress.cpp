@@ -0,0 +1,120 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include <CommonAPI/InternedAddress.hpp>
+
+namespace CommonAPI {
+
+class InternedAddress::Table {
+public:
+    const Entry *intern(const Address &_address) {
+        {
+            std::shared_lock<std::shared_mutex> itsLock(mutex_);
+            const Entry *itsEntry = find(_address);
+            if (itsEntry)
+                return itsEntry;
+        }
+
+        std::unique_lock<std::shared_mutex> itsLock(mutex_);
+        const Entry *itsEntry = find(_address);
+        if (itsEntry)
+            return itsEntry;
+
+        std::unique_ptr<Entry> itsNewEntry(new Entry());
+        itsNewEntry->domain_ = getId(_address.getDomain());
+        itsNewEntry->interface_ = getId(_address.getInterface());
+        itsNewEntry->instance_ = getId(_address.getInstance());
+        itsNewEntry->address_ = _address;
+        itsNewEntry->string_ = _address.getAddress();
+        itsNewEntry->hash_ = std::hash<std::string>()(itsNewEntry->string_);
+
+        itsEntry = itsNewEntry.get();
+        entries_[Key{ itsEntry->domain_, itsEntry->interface_, itsEntry->instance_ }]
+            = std::move(itsNewEntry);
+        return itsEntry;
+    }
+
+private:
+    struct Key {
+        uint32_t domain_;
+        uint32_t interface_;
+        uint32_t instance_;
+
+        bool operator==(const Key &_other) const {
+            return (domain_ == _other.domain_
+                    && interface_ == _other.interface_
+                    && instance_ == _other.instance_);
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key &_key) const {
+            uint64_t itsHash = (uint64_t(_key.domain_) << 32) ^ _key.interface_;
+            itsHash = itsHash * 0x9e3779b97f4a7c15ull ^ _key.instance_;
+            return std::hash<uint64_t>()(itsHash);
+        }
+    };
+
+    // Must be called with the mutex locked
+    const Entry *find(const Address &_address) const {
+        auto itsDomain = ids_.find(_address.getDomain());
+        auto itsInterface = ids_.find(_address.getInterface());
+        auto itsInstance = ids_.find(_address.getInstance());
+        if (itsDomain == ids_.end() || itsInterface == ids_.end() || itsInstance == ids_.end())
+            return nullptr;
+
+        auto itsEntry = entries_.find(Key{ itsDomain->second, itsInterface->second, itsInstance->second });
+        return (itsEntry != entries_.end() ? itsEntry->second.get() : nullptr);
+    }
+
+    // Must be called with the mutex locked exclusively
+    uint32_t getId(const std::string &_name) {
+        return ids_.emplace(_name, static_cast<uint32_t>(ids_.size())).first->second;
+    }
+
+    std::shared_mutex mutex_;
+    std::unordered_map<std::string, uint32_t> ids_;
+    std::unordered_map<Key, std::unique_ptr<Entry>, KeyHash> entries_;
+};
+
+const InternedAddress::Entry *
+InternedAddress::intern(const Address &_address) {
+    // Intentionally never destroyed, as interned addresses may be used
+    // by static objects until the very end of the process.
+    static Table *theTable = new Table();
+    return theTable->intern(_address);
+}
+
+InternedAddress::InternedAddress() {
+    static const Entry *theEmptyEntry = intern(Address());
+    entry_ = theEmptyEntry;
+}
+
+InternedAddress::InternedAddress(const Address &_address)
+    : entry_(intern(_address)) {
+}
+
+InternedAddress::InternedAddress(const std::string &_address)
+    : entry_(intern(Address(_address))) {
+}
+
+InternedAddress::InternedAddress(const std::string &_domain,
+                                 const std::string &_interface,
+                                 const std::string &_instance)
+    : entry_(intern(Address(_domain, _interface, _instance))) {
+}
+
+std::ostream &
+operator<<(std::ostream &_out, const InternedAddress &_address) {
+    _out << _address.entry_->string_;
+    return _out;
+}
+
+} // namespace CommonAPI
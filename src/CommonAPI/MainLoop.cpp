@@ -0,0 +1,1090 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifdef __linux__
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#ifdef COMMONAPI_ENABLE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <thread>
+
+#include <CommonAPI/Logger.hpp>
+#include <CommonAPI/MainLoop.hpp>
+
+namespace CommonAPI {
+
+static const int MAX_POLL_EVENTS = 64;
+
+/**
+ * Workers with a queue per priority. Workers take the oldest task of
+ * the highest priority from their own queues and, if these are empty,
+ * steal the newest task of the highest priority from the other workers.
+ * Tasks that are still queued on destruction are dropped.
+ */
+class MainLoop::WorkerPool {
+public:
+    typedef std::function<void()> Task;
+
+    WorkerPool(std::size_t _numberOfThreads)
+        : next_(0), pending_(0), isRunning_(true) {
+        for (std::size_t i = 0; i < _numberOfThreads; i++)
+            workers_.emplace_back(new Worker());
+        for (std::size_t i = 0; i < _numberOfThreads; i++)
+            workers_[i]->thread_ = std::thread([this, i]() { run(i); });
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> itsLock(idleMutex_);
+            isRunning_ = false;
+        }
+        idleCondition_.notify_all();
+        for (auto &w : workers_)
+            w->thread_.join();
+    }
+
+    void submit(std::size_t _priority, Task _task) {
+        Worker &itsWorker = *workers_[next_++ % workers_.size()];
+        {
+            std::lock_guard<std::mutex> itsLock(itsWorker.mutex_);
+            itsWorker.queues_[_priority].push_back(std::move(_task));
+        }
+        {
+            std::lock_guard<std::mutex> itsLock(idleMutex_);
+            pending_++;
+        }
+        idleCondition_.notify_one();
+    }
+
+private:
+    struct Worker {
+        std::mutex mutex_;
+        std::deque<Task> queues_[NUMBER_OF_PRIORITIES];
+        std::thread thread_;
+    };
+
+    bool take(std::size_t _index, Task &_task) {
+        for (std::size_t p = 0; p < NUMBER_OF_PRIORITIES; p++) {
+            for (std::size_t i = 0; i < workers_.size(); i++) {
+                Worker &itsWorker = *workers_[(_index + i) % workers_.size()];
+                std::lock_guard<std::mutex> itsLock(itsWorker.mutex_);
+                std::deque<Task> &itsQueue = itsWorker.queues_[p];
+                if (itsQueue.empty())
+                    continue;
+                if (i == 0) {
+                    _task = std::move(itsQueue.front());
+                    itsQueue.pop_front();
+                } else {
+                    _task = std::move(itsQueue.back());
+                    itsQueue.pop_back();
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run(std::size_t _index) {
+        while (true) {
+            {
+                std::unique_lock<std::mutex> itsLock(idleMutex_);
+                idleCondition_.wait(itsLock, [this]() {
+                    return (!isRunning_ || pending_ > 0);
+                });
+                if (!isRunning_)
+                    return;
+            }
+
+            Task itsTask;
+            if (!take(_index, itsTask)) {
+                // Taken by another worker that did not yet account for it
+                std::this_thread::yield();
+                continue;
+            }
+            {
+                std::lock_guard<std::mutex> itsLock(idleMutex_);
+                pending_--;
+            }
+            itsTask();
+        }
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<std::size_t> next_;
+
+    std::mutex idleMutex_;
+    std::condition_variable idleCondition_;
+    std::size_t pending_;
+    bool isRunning_;
+};
+
+/**
+ * Monitors file descriptors for poll events. Events are given and
+ * reported as epoll flags, which share their values with the poll flags.
+ * Registrations may be changed from any thread while another one waits.
+ */
+class MainLoop::Poller {
+public:
+    enum class Trigger {
+        LEVEL,
+        ONE_SHOT, // reported once, must be set again afterwards
+        EDGE      // only for descriptors that are drained on each event
+    };
+
+    typedef MainLoop::PollEvent Event;
+
+    virtual ~Poller() {}
+
+    virtual bool isValid() const = 0;
+    virtual bool hasLevelTrigger() const = 0;
+
+    virtual bool set(int _fd, uint32_t _events, Trigger _trigger, bool _isRegistered) = 0;
+    virtual void remove(int _fd) = 0;
+
+    /**
+     * Waits at most the given number of milliseconds (-1 for infinite)
+     * for ready file descriptors and returns their number.
+     */
+    virtual int wait(Event *_events, int _maxEvents, int _timeout) = 0;
+};
+
+class MainLoop::EpollPoller : public MainLoop::Poller {
+public:
+    EpollPoller()
+        : epollFd_(epoll_create1(EPOLL_CLOEXEC)) {
+    }
+
+    ~EpollPoller() {
+        if (epollFd_ >= 0)
+            close(epollFd_);
+    }
+
+    bool isValid() const {
+        return (epollFd_ >= 0);
+    }
+
+    bool hasLevelTrigger() const {
+        return true;
+    }
+
+    bool set(int _fd, uint32_t _events, Trigger _trigger, bool _isRegistered) {
+        epoll_event itsEvent;
+        itsEvent.events = _events;
+        if (_trigger == Trigger::ONE_SHOT)
+            itsEvent.events |= EPOLLONESHOT;
+        else if (_trigger == Trigger::EDGE)
+            itsEvent.events |= EPOLLET;
+        itsEvent.data.fd = _fd;
+        return (epoll_ctl(epollFd_, (_isRegistered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD), _fd, &itsEvent) == 0);
+    }
+
+    void remove(int _fd) {
+        // Fails if the descriptor was closed before, which is fine
+        (void)epoll_ctl(epollFd_, EPOLL_CTL_DEL, _fd, nullptr);
+    }
+
+    int wait(Event *_events, int _maxEvents, int _timeout) {
+        epoll_event itsEvents[MAX_POLL_EVENTS];
+        int itsCount = epoll_wait(epollFd_, itsEvents, std::min(_maxEvents, MAX_POLL_EVENTS), _timeout);
+        if (itsCount < 0) {
+            if (errno != EINTR)
+                COMMONAPI_ERROR("MainLoop: epoll_wait failed: ", std::strerror(errno));
+            return 0;
+        }
+        for (int i = 0; i < itsCount; i++)
+            _events[i] = { itsEvents[i].data.fd, itsEvents[i].events };
+        return itsCount;
+    }
+
+private:
+    int epollFd_;
+};
+
+#ifdef COMMONAPI_ENABLE_IO_URING
+/**
+ * Poller based on io_uring poll requests, without liburing.
+ *
+ * Requests are queued to the submission ring and submitted by the next
+ * wait, together with waiting for completions. Requests queued while the
+ * loop waits are submitted directly. Completions are tagged with the file
+ * descriptor and a generation that is incremented whenever the request of
+ * the descriptor is replaced, completions of replaced requests are ignored.
+ * Poll requests do not support level triggered monitoring, thus watches
+ * are monitored one-shot.
+ */
+class MainLoop::UringPoller : public MainLoop::Poller {
+public:
+    UringPoller()
+        : ringFd_(-1), ring_(MAP_FAILED), ringSize_(0), sqes_(MAP_FAILED), sqesSize_(0),
+          sqTail_(0), unsubmitted_(0), isWaiting_(false), isMultiShot_(true) {
+        io_uring_params itsParams;
+        std::memset(&itsParams, 0, sizeof(itsParams));
+        itsParams.flags = IORING_SETUP_CQSIZE;
+        itsParams.cq_entries = 4 * NUMBER_OF_ENTRIES;
+        ringFd_ = static_cast<int>(syscall(__NR_io_uring_setup, NUMBER_OF_ENTRIES, &itsParams));
+        if (ringFd_ < 0)
+            return;
+
+        // Single mmap since 5.4, waiting with a timeout since 5.11
+        if (!(itsParams.features & IORING_FEAT_SINGLE_MMAP)
+                || !(itsParams.features & IORING_FEAT_EXT_ARG)) {
+            close(ringFd_);
+            ringFd_ = -1;
+            return;
+        }
+
+        ringSize_ = std::max(itsParams.sq_off.array + itsParams.sq_entries * sizeof(uint32_t),
+                             itsParams.cq_off.cqes + itsParams.cq_entries * sizeof(io_uring_cqe));
+        ring_ = mmap(nullptr, ringSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     ringFd_, IORING_OFF_SQ_RING);
+        sqesSize_ = itsParams.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     ringFd_, IORING_OFF_SQES);
+        if (ring_ == MAP_FAILED || sqes_ == MAP_FAILED)
+            return;
+
+        char *itsRing = static_cast<char *>(ring_);
+        sqHead_ = reinterpret_cast<uint32_t *>(itsRing + itsParams.sq_off.head);
+        sqTailShared_ = reinterpret_cast<uint32_t *>(itsRing + itsParams.sq_off.tail);
+        sqMask_ = *reinterpret_cast<uint32_t *>(itsRing + itsParams.sq_off.ring_mask);
+        sqEntries_ = itsParams.sq_entries;
+        cqHead_ = reinterpret_cast<uint32_t *>(itsRing + itsParams.cq_off.head);
+        cqTail_ = reinterpret_cast<uint32_t *>(itsRing + itsParams.cq_off.tail);
+        cqMask_ = *reinterpret_cast<uint32_t *>(itsRing + itsParams.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe *>(itsRing + itsParams.cq_off.cqes);
+
+        // Submission queue entries are used in ring order
+        uint32_t *itsArray = reinterpret_cast<uint32_t *>(itsRing + itsParams.sq_off.array);
+        for (uint32_t i = 0; i < sqEntries_; i++)
+            itsArray[i] = i;
+        sqTail_ = *sqTailShared_;
+    }
+
+    ~UringPoller() {
+        if (sqes_ != MAP_FAILED)
+            munmap(sqes_, sqesSize_);
+        if (ring_ != MAP_FAILED)
+            munmap(ring_, ringSize_);
+        if (ringFd_ >= 0)
+            close(ringFd_);
+    }
+
+    bool isValid() const {
+        return (ringFd_ >= 0 && ring_ != MAP_FAILED && sqes_ != MAP_FAILED);
+    }
+
+    bool hasLevelTrigger() const {
+        return false;
+    }
+
+    bool set(int _fd, uint32_t _events, Trigger _trigger, bool _isRegistered) {
+        (void)_isRegistered;
+
+        std::lock_guard<std::mutex> itsLock(mutex_);
+        Request &itsRequest = requests_[_fd];
+        if (itsRequest.isArmed_)
+            cancel(_fd, itsRequest);
+        itsRequest.generation_++;
+        itsRequest.events_ = _events;
+        itsRequest.trigger_ = (_trigger == Trigger::EDGE ? Trigger::EDGE : Trigger::ONE_SHOT);
+        return arm(_fd, itsRequest);
+    }
+
+    void remove(int _fd) {
+        std::lock_guard<std::mutex> itsLock(mutex_);
+        auto itsRequest = requests_.find(_fd);
+        if (itsRequest == requests_.end())
+            return;
+        if (itsRequest->second.isArmed_)
+            cancel(_fd, itsRequest->second);
+        requests_.erase(itsRequest);
+    }
+
+    int wait(Event *_events, int _maxEvents, int _timeout) {
+        unsigned int itsSubmit;
+        {
+            std::lock_guard<std::mutex> itsLock(mutex_);
+            itsSubmit = unsubmitted_;
+            unsubmitted_ = 0;
+            isWaiting_ = true;
+        }
+
+        __kernel_timespec itsTimeout;
+        io_uring_getevents_arg itsArgument;
+        std::memset(&itsArgument, 0, sizeof(itsArgument));
+        if (_timeout >= 0) {
+            itsTimeout.tv_sec = _timeout / 1000;
+            itsTimeout.tv_nsec = (_timeout % 1000) * 1000000;
+            itsArgument.ts = reinterpret_cast<uint64_t>(&itsTimeout);
+        }
+
+        bool hasCompletions = (__atomic_load_n(cqTail_, __ATOMIC_ACQUIRE) != *cqHead_);
+        unsigned int itsMinimum = ((_timeout == 0 || hasCompletions) ? 0 : 1);
+        long itsResult = syscall(__NR_io_uring_enter, ringFd_, itsSubmit, itsMinimum,
+                                 IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG,
+                                 &itsArgument, sizeof(itsArgument));
+        int itsError = errno;
+
+        std::lock_guard<std::mutex> itsLock(mutex_);
+        isWaiting_ = false;
+        if (itsResult < 0) {
+            // Nothing was submitted
+            unsubmitted_ += itsSubmit;
+            if (itsError != ETIME && itsError != EINTR && itsError != EAGAIN && itsError != EBUSY)
+                COMMONAPI_ERROR("MainLoop: io_uring_enter failed: ", std::strerror(itsError));
+        } else if (static_cast<unsigned long>(itsResult) < itsSubmit) {
+            unsubmitted_ += itsSubmit - static_cast<unsigned int>(itsResult);
+        }
+
+        return reap(_events, _maxEvents);
+    }
+
+private:
+    static const unsigned int NUMBER_OF_ENTRIES = 256;
+    static const uint64_t CANCEL_DATA = ~uint64_t(0);
+
+    struct Request {
+        Request() : generation_(0), events_(0), trigger_(Trigger::ONE_SHOT), isArmed_(false) {}
+
+        uint32_t generation_;
+        uint32_t events_;
+        Trigger trigger_;
+        bool isArmed_;
+    };
+
+    static uint64_t getData(int _fd, const Request &_request) {
+        return ((uint64_t(_request.generation_) << 32) | static_cast<uint32_t>(_fd));
+    }
+
+    // All following methods must be called with the lock held
+
+    // The kernel reads poll32_events with its 16 bit halves swapped on
+    // big endian systems, the result of a completion is in host order.
+    static uint32_t toPollEvents(uint32_t _events) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        return ((_events << 16) | (_events >> 16));
+#else
+        return _events;
+#endif
+    }
+
+    io_uring_sqe *getSqe() {
+        if (sqTail_ - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE) >= sqEntries_) {
+            submit();
+            if (sqTail_ - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE) >= sqEntries_)
+                return nullptr;
+        }
+        io_uring_sqe *itsSqe = &static_cast<io_uring_sqe *>(sqes_)[sqTail_ & sqMask_];
+        std::memset(itsSqe, 0, sizeof(*itsSqe));
+        return itsSqe;
+    }
+
+    void push() {
+        __atomic_store_n(sqTailShared_, ++sqTail_, __ATOMIC_RELEASE);
+        unsubmitted_++;
+        // A waiting loop would not submit the request before it wakes up
+        if (isWaiting_)
+            submit();
+    }
+
+    void submit() {
+        if (unsubmitted_ == 0)
+            return;
+        long itsResult = syscall(__NR_io_uring_enter, ringFd_, unsubmitted_, 0, 0, nullptr, 0);
+        if (itsResult > 0)
+            unsubmitted_ -= static_cast<unsigned int>(itsResult);
+    }
+
+    bool arm(int _fd, Request &_request) {
+        io_uring_sqe *itsSqe = getSqe();
+        if (!itsSqe) {
+            COMMONAPI_ERROR("MainLoop: cannot monitor file descriptor ", _fd, ": submission queue full");
+            return false;
+        }
+        itsSqe->opcode = IORING_OP_POLL_ADD;
+        itsSqe->fd = _fd;
+        itsSqe->poll32_events = toPollEvents(_request.events_);
+        if (_request.trigger_ == Trigger::EDGE && isMultiShot_)
+            itsSqe->len = IORING_POLL_ADD_MULTI;
+        itsSqe->user_data = getData(_fd, _request);
+        push();
+        _request.isArmed_ = true;
+        return true;
+    }
+
+    void cancel(int _fd, Request &_request) {
+        io_uring_sqe *itsSqe = getSqe();
+        if (itsSqe) {
+            itsSqe->opcode = IORING_OP_POLL_REMOVE;
+            itsSqe->fd = -1;
+            itsSqe->addr = getData(_fd, _request);
+            itsSqe->user_data = CANCEL_DATA;
+            push();
+        }
+        _request.isArmed_ = false;
+    }
+
+    int reap(Event *_events, int _maxEvents) {
+        int itsCount(0);
+        uint32_t itsHead = *cqHead_;
+        uint32_t itsTail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+        for (; itsHead != itsTail && itsCount < _maxEvents; itsHead++) {
+            const io_uring_cqe &itsCqe = cqes_[itsHead & cqMask_];
+            if (itsCqe.user_data == CANCEL_DATA)
+                continue;
+
+            int fd = static_cast<int>(static_cast<uint32_t>(itsCqe.user_data));
+            auto itsRequest = requests_.find(fd);
+            if (itsRequest == requests_.end()
+                    || getData(fd, itsRequest->second) != itsCqe.user_data)
+                continue;
+
+            Request &itsEntry = itsRequest->second;
+            bool hasMore = ((itsCqe.flags & IORING_CQE_F_MORE) != 0);
+            if (!hasMore)
+                itsEntry.isArmed_ = false;
+
+            if (itsCqe.res < 0) {
+                if (itsCqe.res == -EINVAL && itsEntry.trigger_ == Trigger::EDGE && isMultiShot_) {
+                    // Multishot poll requires 5.13
+                    isMultiShot_ = false;
+                    (void)arm(fd, itsEntry);
+                } else if (itsCqe.res == -ECANCELED && itsEntry.trigger_ == Trigger::EDGE) {
+                    (void)arm(fd, itsEntry);
+                } else if (itsCqe.res != -EBADF) {
+                    // Closed descriptors are dropped silently, like by epoll
+                    _events[itsCount++] = { fd, EPOLLERR };
+                }
+                continue;
+            }
+
+            _events[itsCount++] = { fd, static_cast<uint32_t>(itsCqe.res) };
+            if (!hasMore && itsEntry.trigger_ == Trigger::EDGE)
+                (void)arm(fd, itsEntry);
+        }
+        __atomic_store_n(cqHead_, itsHead, __ATOMIC_RELEASE);
+        return itsCount;
+    }
+
+    int ringFd_;
+    void *ring_;
+    std::size_t ringSize_;
+    void *sqes_;
+    std::size_t sqesSize_;
+
+    uint32_t *sqHead_;
+    uint32_t *sqTailShared_;
+    uint32_t sqMask_;
+    uint32_t sqEntries_;
+    uint32_t *cqHead_;
+    uint32_t *cqTail_;
+    uint32_t cqMask_;
+    io_uring_cqe *cqes_;
+
+    std::mutex mutex_;
+    uint32_t sqTail_;
+    unsigned int unsubmitted_;
+    bool isWaiting_;
+    bool isMultiShot_;
+    std::unordered_map<int, Request> requests_;
+};
+#endif // COMMONAPI_ENABLE_IO_URING
+
+MainLoop::MainLoop(std::shared_ptr<MainLoopContext> _context, std::size_t _numberOfDispatchThreads)
+    : context_(_context),
+      isOneShot_(false),
+      wakeupFd_(-1),
+      timerFd_(-1),
+      armedTime_(TIMEOUT_INFINITE),
+      isRunning_(false),
+      maximumSpinBudget_(0),
+      spinBudget_(0),
+      lastReadyTime_(0),
+      averageReadyInterval_(0),
+      spins_(0),
+      spinHits_(0),
+      wakeupTime_(0),
+      rotation_(),
+      timeouts_(getCurrentTimeInMs()) {
+    if (_numberOfDispatchThreads > 0)
+        workerPool_.reset(new WorkerPool(_numberOfDispatchThreads));
+
+#ifdef COMMONAPI_ENABLE_IO_URING
+    const char *itsPoller = std::getenv("COMMONAPI_MAINLOOP_POLLER");
+    if (!itsPoller || std::strcmp(itsPoller, "epoll") != 0)
+        poller_.reset(new UringPoller());
+    if (poller_ && !poller_->isValid()) {
+        COMMONAPI_WARNING("MainLoop: io_uring is not available, using epoll");
+        poller_.reset();
+    }
+#endif
+    if (!poller_)
+        poller_.reset(new EpollPoller());
+    isOneShot_ = (workerPool_ || !poller_->hasLevelTrigger());
+
+    wakeupFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    timerFd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (!poller_->isValid() || wakeupFd_ < 0 || timerFd_ < 0) {
+        COMMONAPI_ERROR("MainLoop: cannot create file descriptors: ", std::strerror(errno));
+    }
+
+    // Both descriptors are drained whenever they become ready,
+    // thus edge triggered notification is sufficient.
+    for (int fd : { wakeupFd_, timerFd_ }) {
+        if (!poller_->set(fd, EPOLLIN, Poller::Trigger::EDGE, false)) {
+            COMMONAPI_ERROR("MainLoop: cannot monitor file descriptor ", fd, ": ", std::strerror(errno));
+        }
+    }
+
+    sourceSubscription_ = context_->subscribeForDispatchSources(
+        [this](DispatchSource *_source, const DispatchPriority _priority) {
+            registerSource(_source, _priority);
+        },
+        [this](DispatchSource *_source) {
+            deregisterSource(_source);
+        });
+    watchSubscription_ = context_->subscribeForWatches(
+        [this](Watch *_watch, const DispatchPriority _priority) {
+            registerWatch(_watch, _priority);
+        },
+        [this](Watch *_watch) {
+            deregisterWatch(_watch);
+        });
+    timeoutSubscription_ = context_->subscribeForTimeouts(
+        [this](Timeout *_timeout, const DispatchPriority _priority) {
+            registerTimeout(_timeout, _priority);
+        },
+        [this](Timeout *_timeout) {
+            deregisterTimeout(_timeout);
+        });
+    wakeupSubscription_ = context_->subscribeForWakeupEvents(
+        [this]() {
+            wakeup();
+        });
+    context_->setWakeupCoalescing(true);
+}
+
+MainLoop::~MainLoop() {
+    context_->setWakeupCoalescing(false);
+    context_->unsubscribeForDispatchSources(sourceSubscription_);
+    context_->unsubscribeForWatches(watchSubscription_);
+    context_->unsubscribeForTimeouts(timeoutSubscription_);
+    context_->unsubscribeForWakeupEvents(wakeupSubscription_);
+
+    // Workers may still wake up the loop
+    workerPool_.reset();
+
+    poller_.reset();
+    for (int fd : { timerFd_, wakeupFd_ }) {
+        if (fd >= 0)
+            close(fd);
+    }
+}
+
+void
+MainLoop::run() {
+    isRunning_ = true;
+    while (isRunning_)
+        (void)iterate();
+}
+
+void
+MainLoop::stop() {
+    isRunning_ = false;
+    wakeup();
+}
+
+bool
+MainLoop::isRunning() const {
+    return isRunning_;
+}
+
+void
+MainLoop::setSpinBudget(std::chrono::microseconds _maximum) {
+    int64_t itsMaximum = std::chrono::duration_cast<std::chrono::nanoseconds>(_maximum).count();
+    maximumSpinBudget_ = std::max(itsMaximum, int64_t(0));
+    spinBudget_ = maximumSpinBudget_.load();
+}
+
+MainLoopSpinStatistics
+MainLoop::getSpinStatistics() const {
+    MainLoopSpinStatistics itsStatistics;
+    itsStatistics.spins_ = spins_;
+    itsStatistics.hits_ = spinHits_;
+    itsStatistics.budget_ = spinBudget_;
+    itsStatistics.spinTime_ = spinTime_.getSnapshot();
+    itsStatistics.wakeLatency_ = wakeLatency_.getSnapshot();
+    return itsStatistics;
+}
+
+void
+MainLoop::setTimeoutPolling(bool _isEnabled) {
+    timeouts_.setPolling(_isEnabled);
+}
+
+void
+MainLoop::wakeup() {
+    // Only the first of several wakeups is measured
+    int64_t itsNone(0);
+    (void)wakeupTime_.compare_exchange_strong(itsNone, getCurrentTimeInNs());
+
+    uint64_t itsValue(1);
+    if (write(wakeupFd_, &itsValue, sizeof(itsValue)) < 0 && errno != EAGAIN) {
+        COMMONAPI_ERROR("MainLoop: wakeup failed: ", std::strerror(errno));
+    }
+}
+
+bool
+MainLoop::iterate(int64_t _timeout) {
+    ReadyList itsReady[NUMBER_OF_PRIORITIES];
+
+    std::vector<std::shared_ptr<SourceEntry>> itsUnready;
+    int64_t itsTimeout(_timeout);
+    bool hasReadySources = prepareSources(itsReady, itsUnready, itsTimeout);
+
+    rescheduleTimeouts();
+    int64_t itsReadyTime = getNextReadyTime();
+    armTimer(itsReadyTime);
+
+    if (hasReadySources || itsReadyTime <= getCurrentTimeInMs())
+        itsTimeout = TIMEOUT_NONE;
+
+    int itsWaitTime(-1);
+    if (itsTimeout != TIMEOUT_INFINITE)
+        itsWaitTime = static_cast<int>(std::min(std::max(itsTimeout, int64_t(0)), int64_t(INT_MAX)));
+
+    PollEvent itsEvents[MAX_POLL_EVENTS];
+    int itsCount(0);
+    bool isReady(false);
+    if (itsTimeout != TIMEOUT_NONE && spinBudget_ > 0) {
+        int64_t itsStart = getCurrentTimeInMs();
+        itsCount = spin(itsEvents, MAX_POLL_EVENTS, itsUnready, itsReadyTime, itsTimeout, isReady);
+        if (itsWaitTime > 0)
+            itsWaitTime = std::max(itsWaitTime - static_cast<int>(getCurrentTimeInMs() - itsStart), 0);
+    }
+    if (!isReady)
+        itsCount = poller_->wait(itsEvents, MAX_POLL_EVENTS, itsWaitTime);
+
+    int64_t itsNow = getCurrentTimeInNs();
+    int64_t itsWakeupTime = wakeupTime_.exchange(0);
+    if (itsWakeupTime > 0)
+        wakeLatency_.record(std::chrono::nanoseconds(itsNow - itsWakeupTime));
+    if (itsCount > 0 || isReady)
+        adaptSpinBudget(itsNow);
+
+    // Wakeups of the context that happen from now on are not
+    // covered by this iteration and must wake up the next one.
+    context_->acknowledgeWakeup();
+
+    for (int i = 0; i < itsCount; i++) {
+        int fd = itsEvents[i].fd_;
+        if (fd == wakeupFd_ || fd == timerFd_) {
+            drain(fd);
+            if (fd == timerFd_)
+                armedTime_ = TIMEOUT_INFINITE;
+        } else {
+            collectWatches(fd, itsEvents[i].events_, itsReady);
+        }
+    }
+
+    for (auto &s : itsUnready) {
+        if (s->source_->check())
+            itsReady[static_cast<std::size_t>(s->priority_)].sources_.push_back(s);
+    }
+
+    collectTimeouts(itsReady);
+
+    return (dispatch(itsReady) > 0);
+}
+
+bool
+MainLoop::prepareSources(ReadyList *_ready, std::vector<std::shared_ptr<SourceEntry>> &_unready,
+                         int64_t &_timeout) {
+    std::vector<std::shared_ptr<SourceEntry>> itsSources;
+    {
+        std::lock_guard<std::mutex> itsLock(mutex_);
+        itsSources.reserve(sources_.size());
+        for (auto &s : sources_) {
+            if (!s.second->isBusy_)
+                itsSources.push_back(s.second);
+        }
+    }
+
+    bool hasReadySources(false);
+    for (auto &s : itsSources) {
+        int64_t itsSourceTimeout(TIMEOUT_INFINITE);
+        if (s->source_->prepare(itsSourceTimeout)) {
+            _ready[static_cast<std::size_t>(s->priority_)].sources_.push_back(s);
+            hasReadySources = true;
+        } else {
+            _unready.push_back(s);
+            _timeout = std::min(_timeout, itsSourceTimeout);
+        }
+    }
+    return hasReadySources;
+}
+
+int
+MainLoop::spin(PollEvent *_events, int _maxEvents,
+               const std::vector<std::shared_ptr<SourceEntry>> &_unready,
+               int64_t _readyTime, int64_t _timeout, bool &_isReady) {
+    int64_t itsStart = getCurrentTimeInNs();
+    int64_t itsBudget = spinBudget_;
+    if (_timeout <= itsBudget / 1000000)
+        itsBudget = _timeout * 1000000;
+    int64_t itsEnd = itsStart + itsBudget;
+
+    int itsCount(0);
+    int64_t itsNow(itsStart);
+    do {
+        itsCount = poller_->wait(_events, _maxEvents, 0);
+        _isReady = (itsCount > 0 || itsNow / 1000000 >= _readyTime);
+        for (auto it = _unready.begin(); !_isReady && it != _unready.end(); ++it)
+            _isReady = (*it)->source_->check();
+        itsNow = getCurrentTimeInNs();
+    } while (!_isReady && itsNow < itsEnd && isRunning_);
+
+    spins_++;
+    if (_isReady)
+        spinHits_++;
+    spinTime_.record(std::chrono::nanoseconds(itsNow - itsStart));
+    return itsCount;
+}
+
+void
+MainLoop::adaptSpinBudget(int64_t _now) {
+    int64_t itsMaximum = maximumSpinBudget_;
+    if (itsMaximum == 0)
+        return;
+
+    // Exponentially weighted average of the intervals between ready events
+    if (lastReadyTime_ > 0) {
+        int64_t itsInterval = _now - lastReadyTime_;
+        averageReadyInterval_ += (itsInterval - averageReadyInterval_) / 8;
+    }
+    lastReadyTime_ = _now;
+
+    if (averageReadyInterval_ > itsMaximum)
+        spinBudget_ = 0;
+    else
+        spinBudget_ = std::min(2 * averageReadyInterval_, itsMaximum);
+}
+
+int64_t
+MainLoop::getNextReadyTime() {
+    std::lock_guard<std::mutex> itsLock(mutex_);
+    return timeouts_.getNextReadyTime();
+}
+
+void
+MainLoop::collectTimeouts(ReadyList *_ready) {
+    int64_t itsNow = getCurrentTimeInMs();
+
+    std::lock_guard<std::mutex> itsLock(mutex_);
+    timeouts_.collect(itsNow, [this, _ready](const std::shared_ptr<TimeoutEntry> &_entry) {
+        if (workerPool_)
+            _entry->isBusy_ = true;
+        _ready[static_cast<std::size_t>(_entry->priority_)].timeouts_.push_back(_entry);
+    });
+}
+
+void
+MainLoop::collectWatches(const int _fd, const uint32_t _events, ReadyList *_ready) {
+    std::lock_guard<std::mutex> itsLock(mutex_);
+    auto itsDescriptor = descriptors_.find(_fd);
+    if (itsDescriptor == descriptors_.end())
+        return;
+
+    // Poll and epoll share the values of the event flags on Linux
+    Descriptor &itsEntries = itsDescriptor->second;
+    for (auto &w : itsEntries.watches_) {
+        unsigned int itsEvents = (_events & (static_cast<uint32_t>(w->events_) | EPOLLERR | EPOLLHUP));
+        if (itsEvents) {
+            _ready[static_cast<std::size_t>(w->priority_)].watches_.push_back({ w, itsEvents });
+            if (isOneShot_)
+                itsEntries.pending_++;
+        }
+    }
+
+    if (isOneShot_ && itsEntries.pending_ == 0)
+        updateDescriptor(_fd, itsEntries, true);
+}
+
+void
+MainLoop::releaseDescriptor(int _fd) {
+    std::lock_guard<std::mutex> itsLock(mutex_);
+    auto itsDescriptor = descriptors_.find(_fd);
+    if (itsDescriptor != descriptors_.end()
+            && itsDescriptor->second.pending_ > 0
+            && --itsDescriptor->second.pending_ == 0)
+        updateDescriptor(_fd, itsDescriptor->second, true);
+}
+
+std::size_t
+MainLoop::dispatch(ReadyList *_ready) {
+    std::size_t itsCount(0);
+    for (std::size_t p = 0; p < NUMBER_OF_PRIORITIES; p++) {
+        std::vector<std::shared_ptr<SourceEntry>> &itsSources = _ready[p].sources_;
+        if (itsSources.size() > 1) {
+            std::size_t itsFirst = rotation_[p]++ % itsSources.size();
+            std::rotate(itsSources.begin(), itsSources.begin() + static_cast<std::ptrdiff_t>(itsFirst),
+                        itsSources.end());
+        }
+
+        if (!workerPool_) {
+            for (auto &t : _ready[p].timeouts_) {
+                if (t->isActive_) {
+                    dispatchTimeout(t);
+                    itsCount++;
+                }
+            }
+            for (auto &w : _ready[p].watches_) {
+                if (w.entry_->isActive_) {
+                    dispatchWatch(*w.entry_, w.events_);
+                    itsCount++;
+                }
+                if (isOneShot_)
+                    releaseDescriptor(w.entry_->fd_);
+            }
+            for (auto &s : _ready[p].sources_) {
+                if (s->isActive_) {
+                    dispatchSource(*s);
+                    itsCount++;
+                }
+            }
+            continue;
+        }
+
+        // Finished elements must be prepared, checked or polled
+        // again, thus each task wakes up the loop when done.
+        for (auto &t : _ready[p].timeouts_) {
+            workerPool_->submit(p, [this, t]() {
+                dispatchTimeout(t);
+                wakeup();
+            });
+        }
+        for (auto &w : _ready[p].watches_) {
+            std::shared_ptr<WatchEntry> itsEntry(w.entry_);
+            unsigned int itsEvents(w.events_);
+            workerPool_->submit(p, [this, itsEntry, itsEvents]() {
+                dispatchWatch(*itsEntry, itsEvents);
+                releaseDescriptor(itsEntry->fd_);
+            });
+        }
+        for (auto &s : _ready[p].sources_) {
+            s->isBusy_ = true;
+            workerPool_->submit(p, [this, s]() {
+                dispatchSource(*s);
+                s->isBusy_ = false;
+                wakeup();
+            });
+        }
+        itsCount += _ready[p].timeouts_.size() + _ready[p].watches_.size() + _ready[p].sources_.size();
+    }
+    return itsCount;
+}
+
+void
+MainLoop::dispatchTimeout(const std::shared_ptr<TimeoutEntry> &_entry) {
+    if (_entry->isActive_ && !_entry->timeout_->dispatch())
+        deregisterTimeout(_entry->timeout_);
+
+    std::lock_guard<std::mutex> itsLock(mutex_);
+    timeouts_.reschedule(_entry);
+}
+
+void
+MainLoop::dispatchWatch(WatchEntry &_entry, unsigned int _events) {
+    if (_entry.isActive_)
+        _entry.watch_->dispatch(_events);
+}
+
+void
+MainLoop::dispatchSource(SourceEntry &_entry) {
+    if (!_entry.isActive_)
+        return;
+
+    if (!_entry.budgeted_) {
+        (void)_entry.source_->dispatch();
+        return;
+    }
+
+    // Deficit round-robin. The deficit is bounded by a quantum, thus a
+    // source that repeatedly consumes nothing cannot save up units.
+    std::size_t itsQuantum = std::max(_entry.budgeted_->getDispatchQuantum(), std::size_t(1));
+    std::size_t itsBudget = _entry.deficit_ + itsQuantum;
+    std::size_t itsConsumed(0);
+    bool hasMore = _entry.budgeted_->dispatchWithBudget(itsBudget, itsConsumed);
+    if (hasMore)
+        _entry.deficit_ = std::min(itsBudget - std::min(itsConsumed, itsBudget), itsQuantum);
+    else
+        _entry.deficit_ = 0;
+}
+
+void
+MainLoop::registerWatch(Watch *_watch, const DispatchPriority _priority) {
+    const pollfd &itsFileDescriptor = _watch->getAssociatedFileDescriptor();
+
+    std::lock_guard<std::mutex> itsLock(mutex_);
+    if (!watches_.emplace(_watch, itsFileDescriptor.fd).second)
+        return;
+
+    Descriptor &itsDescriptor = descriptors_[itsFileDescriptor.fd];
+    itsDescriptor.watches_.push_back(
+            std::make_shared<WatchEntry>(_watch, _priority, itsFileDescriptor.fd, itsFileDescriptor.events));
+    updateDescriptor(itsFileDescriptor.fd, itsDescriptor);
+}
+
+void
+MainLoop::deregisterWatch(Watch *_watch) {
+    std::lock_guard<std::mutex> itsLock(mutex_);
+    auto itsWatch = watches_.find(_watch);
+    if (itsWatch == watches_.end())
+        return;
+
+    int fd = itsWatch->second;
+    watches_.erase(itsWatch);
+
+    Descriptor &itsDescriptor = descriptors_[fd];
+    auto &itsEntries = itsDescriptor.watches_;
+    for (auto it = itsEntries.begin(); it != itsEntries.end(); ++it) {
+        if ((*it)->watch_ == _watch) {
+            (*it)->isActive_ = false;
+            itsEntries.erase(it);
+            break;
+        }
+    }
+
+    updateDescriptor(fd, itsDescriptor);
+    if (itsEntries.empty())
+        descriptors_.erase(fd);
+}
+
+void
+MainLoop::updateDescriptor(int _fd, Descriptor &_descriptor, bool _rearm) {
+    uint32_t itsEvents(0);
+    for (auto &w : _descriptor.watches_)
+        itsEvents |= static_cast<uint32_t>(w->events_);
+
+    if (_descriptor.watches_.empty()) {
+        if (_descriptor.isRegistered_)
+            poller_->remove(_fd);
+        _descriptor.isRegistered_ = false;
+        return;
+    }
+
+    // Re-armed once the workers are done
+    if (_descriptor.pending_ > 0)
+        return;
+
+    if (_descriptor.isRegistered_ && _descriptor.events_ == itsEvents && !_rearm)
+        return;
+
+    // Level triggered (or one-shot and re-armed after dispatching), as
+    // watches are not required to read all available data
+    Poller::Trigger itsTrigger = (isOneShot_ ? Poller::Trigger::ONE_SHOT : Poller::Trigger::LEVEL);
+    if (!poller_->set(_fd, itsEvents, itsTrigger, _descriptor.isRegistered_)) {
+        COMMONAPI_ERROR("MainLoop: cannot monitor file descriptor ", _fd, ": ", std::strerror(errno));
+        return;
+    }
+    _descriptor.events_ = itsEvents;
+    _descriptor.isRegistered_ = true;
+}
+
+void
+MainLoop::registerTimeout(Timeout *_timeout, const DispatchPriority _priority) {
+    {
+        // Registering a known timeout reschedules it
+        std::lock_guard<std::mutex> itsLock(mutex_);
+        timeouts_.add(_timeout, _priority);
+    }
+    // The timer must be rearmed if the new timeout expires first
+    wakeup();
+}
+
+void
+MainLoop::deregisterTimeout(Timeout *_timeout) {
+    std::lock_guard<std::mutex> itsLock(mutex_);
+    timeouts_.remove(_timeout);
+}
+
+void
+MainLoop::rescheduleTimeouts() {
+    // Timeouts that do not register again if their ready time moves to an
+    // earlier point in time, the lock is only taken if polling is enabled
+    if (!timeouts_.isPolling())
+        return;
+
+    std::lock_guard<std::mutex> itsLock(mutex_);
+    timeouts_.poll();
+}
+
+void
+MainLoop::registerSource(DispatchSource *_source, const DispatchPriority _priority) {
+    {
+        std::lock_guard<std::mutex> itsLock(mutex_);
+        sources_.emplace(_source, std::make_shared<SourceEntry>(_source, _priority));
+    }
+    // The source must be prepared before waiting again
+    wakeup();
+}
+
+void
+MainLoop::deregisterSource(DispatchSource *_source) {
+    std::lock_guard<std::mutex> itsLock(mutex_);
+    auto itsSource = sources_.find(_source);
+    if (itsSource != sources_.end()) {
+        itsSource->second->isActive_ = false;
+        sources_.erase(itsSource);
+    }
+}
+
+void
+MainLoop::armTimer(int64_t _readyTime) {
+    if (_readyTime == armedTime_)
+        return;
+
+    // A zero expiration time would disarm the timer
+    itimerspec itsSpec;
+    std::memset(&itsSpec, 0, sizeof(itsSpec));
+    if (_readyTime != TIMEOUT_INFINITE) {
+        int64_t itsReadyTime = std::max(_readyTime, int64_t(1));
+        itsSpec.it_value.tv_sec = static_cast<time_t>(itsReadyTime / 1000);
+        itsSpec.it_value.tv_nsec = static_cast<long>((itsReadyTime % 1000) * 1000000);
+    }
+
+    if (timerfd_settime(timerFd_, TFD_TIMER_ABSTIME, &itsSpec, nullptr) < 0) {
+        COMMONAPI_ERROR("MainLoop: cannot arm timer: ", std::strerror(errno));
+        return;
+    }
+    armedTime_ = _readyTime;
+}
+
+void
+MainLoop::drain(int _fd) {
+    uint64_t itsValue;
+    while (read(_fd, &itsValue, sizeof(itsValue)) > 0) {
+    }
+}
+
+} // namespace CommonAPI
+
+#endif // __linux__
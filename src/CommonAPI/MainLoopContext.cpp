@@ -3,98 +3,650 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <map>
+#include <thread>
+
 #include <CommonAPI/MainLoopContext.hpp>
 
 namespace CommonAPI {
 
+namespace {
+
+// A call of a listener by the current thread. The calls form a stack
+// per thread, thus unsubscribing can tell its own calls of a listener.
+struct ListenerCall {
+    ListenerCall(std::atomic<std::size_t> &_calls, const void *_entry)
+        : calls_(_calls), entry_(_entry), next_(current__) {
+        calls_.fetch_add(1);
+        current__ = this;
+    }
+
+    ~ListenerCall() {
+        current__ = next_;
+        calls_.fetch_sub(1);
+    }
+
+    static std::size_t count(const void *_entry) {
+        std::size_t itsCount(0);
+        for (const ListenerCall *c = current__; c; c = c->next_) {
+            if (c->entry_ == _entry)
+                itsCount++;
+        }
+        return itsCount;
+    }
+
+    std::atomic<std::size_t> &calls_;
+    const void *entry_;
+    const ListenerCall *next_;
+
+    static thread_local const ListenerCall *current__;
+};
+
+thread_local const ListenerCall *ListenerCall::current__(nullptr);
+
+} // anonymous namespace
+
+// Must be called with the listeners mutex held
+template<typename Listener_>
+void MainLoopContext::addListener(const Listener_ &_listener, Snapshot<Listener_> &_snapshot) {
+    std::vector<std::shared_ptr<ListenerEntry<Listener_>>> itsEntries;
+    typename Snapshot<Listener_>::Reference itsCurrent(_snapshot.load());
+    itsEntries.reserve((itsCurrent ? itsCurrent->size() : 0) + 1);
+    itsEntries.push_back(std::make_shared<ListenerEntry<Listener_>>(_listener));
+    if (itsCurrent)
+        itsEntries.insert(itsEntries.end(), itsCurrent->begin(), itsCurrent->end());
+    _snapshot.emplace(std::move(itsEntries));
+}
+
+// Must be called with the listeners mutex held. The removed entry is
+// inactive, but may still be called by concurrent notifications.
+template<typename Listener_>
+std::shared_ptr<MainLoopContext::ListenerEntry<Listener_>>
+MainLoopContext::removeListener(const Listener_ &_listener, Snapshot<Listener_> &_snapshot) {
+    std::shared_ptr<ListenerEntry<Listener_>> itsRemoved;
+    std::vector<std::shared_ptr<ListenerEntry<Listener_>>> itsEntries;
+    typename Snapshot<Listener_>::Reference itsCurrent(_snapshot.load());
+    if (!itsCurrent)
+        return itsRemoved;
+
+    itsEntries.reserve(itsCurrent->size());
+    for (auto &e : *itsCurrent) {
+        if (e->subscription_ == &_listener)
+            itsRemoved = e;
+        else
+            itsEntries.push_back(e);
+    }
+    if (!itsRemoved)
+        return itsRemoved;
+
+    itsRemoved->isActive_.store(false);
+    if (itsEntries.empty())
+        _snapshot.reset();
+    else
+        _snapshot.emplace(std::move(itsEntries));
+    return itsRemoved;
+}
+
+// Waits until other threads returned from the listener. The wait is
+// bounded by the calls in progress, as no new calls start.
+template<typename Listener_>
+void MainLoopContext::waitForCalls(const ListenerEntry<Listener_> &_entry) {
+    std::size_t itsOwnCalls = ListenerCall::count(&_entry);
+    while (_entry.calls_.load() > itsOwnCalls)
+        std::this_thread::yield();
+}
+
+template<typename Listener_, typename Function_>
+void MainLoopContext::notify(const Snapshot<Listener_> &_snapshot, Function_ _function) {
+    typename Snapshot<Listener_>::Reference itsEntries(_snapshot.load());
+    if (!itsEntries)
+        return;
+
+    for (auto &e : *itsEntries) {
+        // Counted before checking, pairs with deactivating before waiting
+        ListenerCall itsCall(e->calls_, e.get());
+        if (e->isActive_.load())
+            _function(e->listener_);
+    }
+}
+
+// The installed clock, owned by clock__. Plain pointer, as it is
+// read on each call of getCurrentTimeInMs.
+static std::shared_ptr<Clock> clock__;
+static std::atomic<const Clock *> currentClock__(nullptr);
+
+void setClock(std::shared_ptr<Clock> _clock) {
+    currentClock__ = _clock.get();
+    clock__ = std::move(_clock);
+}
+
 int64_t getCurrentTimeInMs() {
+   const Clock *itsClock = currentClock__.load(std::memory_order_acquire);
+   if (itsClock)
+       return itsClock->getCurrentTimeInNs() / 1000000;
    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
 }
 
+int64_t getCurrentTimeInUs() {
+   const Clock *itsClock = currentClock__.load(std::memory_order_acquire);
+   if (itsClock)
+       return itsClock->getCurrentTimeInNs() / 1000;
+   return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int64_t getCurrentTimeInNs() {
+   const Clock *itsClock = currentClock__.load(std::memory_order_acquire);
+   if (itsClock)
+       return itsClock->getCurrentTimeInNs();
+   return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Wraps registered elements into proxies that record their statistics.
+ * The proxies are kept alive by their dispatch, as an element may
+ * deregister itself while it is dispatched.
+ */
+class MainLoopContext::Instrumentation {
+public:
+    class Element : public std::enable_shared_from_this<Element> {
+    public:
+        Element(DispatchStatistics::Kind _kind, const void *_element, DispatchPriority _priority)
+            : kind_(_kind), element_(_element), priority_(_priority), dispatches_(0), moreToDispatch_(0) {}
+
+        virtual ~Element() {}
+
+        void record(int64_t _start, bool _hasMore) {
+            duration_.record(std::chrono::nanoseconds(getCurrentTimeInNs() - _start));
+            dispatches_.fetch_add(1, std::memory_order_relaxed);
+            if (_hasMore)
+                moreToDispatch_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        DispatchStatistics getStatistics() const {
+            DispatchStatistics itsStatistics;
+            itsStatistics.element_ = element_;
+            itsStatistics.kind_ = kind_;
+            itsStatistics.priority_ = priority_;
+            itsStatistics.dispatches_ = dispatches_.load(std::memory_order_relaxed);
+            itsStatistics.moreToDispatch_ = moreToDispatch_.load(std::memory_order_relaxed);
+            itsStatistics.duration_ = duration_.getSnapshot();
+            return itsStatistics;
+        }
+
+    private:
+        const DispatchStatistics::Kind kind_;
+        const void *element_;
+        const DispatchPriority priority_;
+        std::atomic<uint64_t> dispatches_;
+        std::atomic<uint64_t> moreToDispatch_;
+        LatencyHistogram duration_;
+    };
+
+    struct Priority {
+        Priority() : backlog_(0), maxBacklog_(0) {}
+
+        void increaseBacklog() {
+            std::size_t itsBacklog = backlog_.fetch_add(1, std::memory_order_relaxed) + 1;
+            std::size_t itsMax = maxBacklog_.load(std::memory_order_relaxed);
+            while (itsBacklog > itsMax
+                   && !maxBacklog_.compare_exchange_weak(itsMax, itsBacklog, std::memory_order_relaxed)) {
+            }
+        }
+
+        LatencyHistogram starvation_;
+        std::atomic<std::size_t> backlog_;
+        std::atomic<std::size_t> maxBacklog_;
+    };
+
+    // Budgeted, to keep the budget of budgeted sources
+    class Source : public BudgetedDispatchSource, public Element {
+    public:
+        static constexpr DispatchStatistics::Kind KIND = DispatchStatistics::Kind::DISPATCH_SOURCE;
+
+        Source(DispatchSource *_source, DispatchPriority _priority, Priority &_recorder)
+            : Element(KIND, _source, _priority), source_(_source),
+              budgeted_(dynamic_cast<BudgetedDispatchSource *>(_source)),
+              recorder_(_recorder), readyTime_(0) {}
+
+        ~Source() {
+            if (readyTime_ != 0)
+                recorder_.backlog_--;
+        }
+
+        bool prepare(int64_t &_timeout) {
+            bool isReady = source_->prepare(_timeout);
+            if (isReady)
+                setReady();
+            return isReady;
+        }
+
+        bool check() {
+            bool isReady = source_->check();
+            if (isReady)
+                setReady();
+            return isReady;
+        }
+
+        bool dispatch() {
+            return dispatchAndRecord(std::numeric_limits<std::size_t>::max(), nullptr);
+        }
+
+        bool dispatchWithBudget(std::size_t _budget, std::size_t &_consumed) {
+            return dispatchAndRecord(_budget, &_consumed);
+        }
+
+        std::size_t getDispatchQuantum() const {
+            return (budgeted_ ? budgeted_->getDispatchQuantum() : DEFAULT_QUANTUM);
+        }
+
+    private:
+        // Sources that are not budgeted dispatch a single unit
+        bool dispatchAndRecord(std::size_t _budget, std::size_t *_consumed) {
+            std::shared_ptr<Element> itsSelf(shared_from_this());
+            int64_t itsStart = getCurrentTimeInNs();
+            int64_t itsReadyTime = readyTime_.exchange(0);
+            if (itsReadyTime != 0) {
+                recorder_.starvation_.record(std::chrono::nanoseconds(itsStart - itsReadyTime));
+                recorder_.backlog_--;
+            }
+
+            bool hasMore;
+            if (budgeted_ && _consumed) {
+                hasMore = budgeted_->dispatchWithBudget(_budget, *_consumed);
+            } else {
+                hasMore = source_->dispatch();
+                if (_consumed)
+                    *_consumed = 1;
+            }
+            record(itsStart, hasMore);
+            return hasMore;
+        }
+
+        void setReady() {
+            int64_t itsNone(0);
+            if (readyTime_.compare_exchange_strong(itsNone, getCurrentTimeInNs()))
+                recorder_.increaseBacklog();
+        }
+
+        DispatchSource *source_;
+        BudgetedDispatchSource *budgeted_;
+        Priority &recorder_;
+        std::atomic<int64_t> readyTime_;
+    };
+
+    class WatchProxy : public Watch, public Element {
+    public:
+        static constexpr DispatchStatistics::Kind KIND = DispatchStatistics::Kind::WATCH;
+
+        WatchProxy(Watch *_watch, DispatchPriority _priority, Priority &)
+            : Element(KIND, _watch, _priority), watch_(_watch) {}
+
+        void dispatch(unsigned int _eventFlags) {
+            std::shared_ptr<Element> itsSelf(shared_from_this());
+            int64_t itsStart = getCurrentTimeInNs();
+            watch_->dispatch(_eventFlags);
+            record(itsStart, false);
+        }
+
+        const pollfd &getAssociatedFileDescriptor() {
+            return watch_->getAssociatedFileDescriptor();
+        }
+
+#ifdef _WIN32
+        const HANDLE &getAssociatedEvent() {
+            return watch_->getAssociatedEvent();
+        }
+#endif
+
+        const std::vector<DispatchSource *> &getDependentDispatchSources() {
+            return watch_->getDependentDispatchSources();
+        }
+
+    private:
+        Watch *watch_;
+    };
+
+    class TimeoutProxy : public Timeout, public Element {
+    public:
+        static constexpr DispatchStatistics::Kind KIND = DispatchStatistics::Kind::TIMEOUT;
+
+        TimeoutProxy(Timeout *_timeout, DispatchPriority _priority, Priority &_recorder)
+            : Element(KIND, _timeout, _priority), timeout_(_timeout), recorder_(_recorder) {}
+
+        bool dispatch() {
+            std::shared_ptr<Element> itsSelf(shared_from_this());
+            int64_t itsStart = getCurrentTimeInNs();
+            int64_t itsReadyTime = timeout_->getReadyTime();
+            if (itsReadyTime <= itsStart / 1000000) {
+                recorder_.starvation_.record(std::chrono::nanoseconds(itsStart - itsReadyTime * 1000000));
+            }
+            bool isRescheduled = timeout_->dispatch();
+            record(itsStart, false);
+            return isRescheduled;
+        }
+
+        int64_t getTimeoutInterval() const {
+            return timeout_->getTimeoutInterval();
+        }
+
+        int64_t getReadyTime() const {
+            return timeout_->getReadyTime();
+        }
+
+    private:
+        Timeout *timeout_;
+        Priority &recorder_;
+    };
+
+    Instrumentation(const std::string &_name)
+        : name_(_name) {
+    }
+
+    /**
+     * Returns the proxy of the element, created on its first registration.
+     */
+    template<typename Proxy_, typename Element_>
+    Element_ *wrap(Element_ *_element, DispatchPriority _priority) {
+        std::lock_guard<std::mutex> itsLock(mutex_);
+        std::shared_ptr<Element> &itsProxy = elements_[{ Proxy_::KIND, _element }];
+        if (!itsProxy)
+            itsProxy = std::make_shared<Proxy_>(_element, _priority, getPriority(_priority));
+        return static_cast<Proxy_ *>(itsProxy.get());
+    }
+
+    /**
+     * Returns the proxy of the element, or the element itself if it was
+     * registered before the instrumentation was enabled. The proxy is
+     * passed to the caller and released from the instrumentation.
+     */
+    template<typename Proxy_, typename Element_>
+    Element_ *unwrap(Element_ *_element, std::shared_ptr<Element> &_proxy) {
+        std::lock_guard<std::mutex> itsLock(mutex_);
+        auto itsProxy = elements_.find({ Proxy_::KIND, _element });
+        if (itsProxy == elements_.end())
+            return _element;
+        _proxy = std::move(itsProxy->second);
+        elements_.erase(itsProxy);
+        return static_cast<Proxy_ *>(_proxy.get());
+    }
+
+    void getStatistics(MainLoopStatistics &_statistics) {
+        _statistics.name_ = name_;
+        _statistics.elements_.clear();
+        _statistics.priorities_.clear();
+        {
+            std::lock_guard<std::mutex> itsLock(mutex_);
+            _statistics.elements_.reserve(elements_.size());
+            for (auto &e : elements_)
+                _statistics.elements_.push_back(e.second->getStatistics());
+        }
+        for (auto &p : priorities_) {
+            DispatchPriorityStatistics itsStatistics;
+            itsStatistics.starvation_ = p.starvation_.getSnapshot();
+            itsStatistics.backlog_ = p.backlog_.load(std::memory_order_relaxed);
+            itsStatistics.maxBacklog_ = p.maxBacklog_.load(std::memory_order_relaxed);
+            _statistics.priorities_.push_back(std::move(itsStatistics));
+        }
+    }
+
+    const std::string &getName() const {
+        return name_;
+    }
+
+    // Instrumented contexts, to be looked up by name
+    static std::mutex registryMutex__;
+    static std::multimap<std::string, std::weak_ptr<Instrumentation>> registry__;
+
+private:
+    static const std::size_t NUMBER_OF_PRIORITIES = static_cast<std::size_t>(DispatchPriority::VERY_LOW) + 1;
+
+    Priority &getPriority(DispatchPriority _priority) {
+        return priorities_[static_cast<std::size_t>(_priority)];
+    }
+
+    const std::string name_;
+
+    std::mutex mutex_;
+    std::map<std::pair<DispatchStatistics::Kind, const void *>, std::shared_ptr<Element>> elements_;
+    Priority priorities_[NUMBER_OF_PRIORITIES];
+};
+
+std::mutex MainLoopContext::Instrumentation::registryMutex__;
+std::multimap<std::string, std::weak_ptr<MainLoopContext::Instrumentation>>
+    MainLoopContext::Instrumentation::registry__;
+
 const std::string &MainLoopContext::getName() const {
     return name_;
 }
 
 DispatchSourceListenerSubscription MainLoopContext::subscribeForDispatchSources(DispatchSourceAddedCallback dispatchAddedCallback, DispatchSourceRemovedCallback dispatchRemovedCallback) {
+    std::lock_guard<std::mutex> itsLock(listenersMutex_);
     dispatchSourceListeners_.emplace_front(dispatchAddedCallback, dispatchRemovedCallback);
+    addListener(dispatchSourceListeners_.front(), dispatchSourceSnapshot_);
     return dispatchSourceListeners_.begin();
 }
 
 WatchListenerSubscription MainLoopContext::subscribeForWatches(WatchAddedCallback watchAddedCallback, WatchRemovedCallback watchRemovedCallback) {
+    std::lock_guard<std::mutex> itsLock(listenersMutex_);
     watchListeners_.emplace_front(watchAddedCallback, watchRemovedCallback);
+    addListener(watchListeners_.front(), watchSnapshot_);
     return watchListeners_.begin();
 }
 
 TimeoutSourceListenerSubscription MainLoopContext::subscribeForTimeouts(TimeoutSourceAddedCallback timeoutAddedCallback, TimeoutSourceRemovedCallback timeoutRemovedCallback) {
+    std::lock_guard<std::mutex> itsLock(listenersMutex_);
     timeoutSourceListeners_.emplace_front(timeoutAddedCallback, timeoutRemovedCallback);
+    addListener(timeoutSourceListeners_.front(), timeoutSourceSnapshot_);
     return timeoutSourceListeners_.begin();
 }
 
 WakeupListenerSubscription MainLoopContext::subscribeForWakeupEvents(WakeupCallback wakeupCallback) {
+    std::lock_guard<std::mutex> itsLock(listenersMutex_);
     wakeupListeners_.emplace_front(wakeupCallback);
+    addListener(wakeupListeners_.front(), wakeupSnapshot_);
     return wakeupListeners_.begin();
 }
 
 void MainLoopContext::unsubscribeForDispatchSources(DispatchSourceListenerSubscription subscription) {
-    dispatchSourceListeners_.erase(subscription);
+    std::shared_ptr<ListenerEntry<DispatchSourceListenerList::value_type>> itsRemoved;
+    {
+        std::lock_guard<std::mutex> itsLock(listenersMutex_);
+        itsRemoved = removeListener(*subscription, dispatchSourceSnapshot_);
+        dispatchSourceListeners_.erase(subscription);
+    }
+    if (itsRemoved)
+        waitForCalls(*itsRemoved);
 }
 
 void MainLoopContext::unsubscribeForWatches(WatchListenerSubscription subscription) {
-    watchListeners_.erase(subscription);
+    std::shared_ptr<ListenerEntry<WatchListenerList::value_type>> itsRemoved;
+    {
+        std::lock_guard<std::mutex> itsLock(listenersMutex_);
+        itsRemoved = removeListener(*subscription, watchSnapshot_);
+        watchListeners_.erase(subscription);
+    }
+    if (itsRemoved)
+        waitForCalls(*itsRemoved);
 }
 
 void MainLoopContext::unsubscribeForTimeouts(TimeoutSourceListenerSubscription subscription) {
-    timeoutSourceListeners_.erase(subscription);
+    std::shared_ptr<ListenerEntry<TimeoutSourceListenerList::value_type>> itsRemoved;
+    {
+        std::lock_guard<std::mutex> itsLock(listenersMutex_);
+        itsRemoved = removeListener(*subscription, timeoutSourceSnapshot_);
+        timeoutSourceListeners_.erase(subscription);
+    }
+    if (itsRemoved)
+        waitForCalls(*itsRemoved);
 }
 
 void MainLoopContext::unsubscribeForWakeupEvents(WakeupListenerSubscription subscription) {
-    wakeupListeners_.erase(subscription);
+    std::shared_ptr<ListenerEntry<WakeupListenerList::value_type>> itsRemoved;
+    {
+        std::lock_guard<std::mutex> itsLock(listenersMutex_);
+        itsRemoved = removeListener(*subscription, wakeupSnapshot_);
+        wakeupListeners_.erase(subscription);
+    }
+    if (itsRemoved)
+        waitForCalls(*itsRemoved);
 }
 
 void MainLoopContext::registerDispatchSource(DispatchSource* dispatchSource, const DispatchPriority dispatchPriority) {
-    for(auto listener = dispatchSourceListeners_.begin(); listener != dispatchSourceListeners_.end(); ++listener) {
-        listener->first(dispatchSource, dispatchPriority);
-    }
+    std::shared_ptr<Instrumentation> itsInstrumentation = getInstrumentation();
+    if (itsInstrumentation)
+        dispatchSource = itsInstrumentation->wrap<Instrumentation::Source>(dispatchSource, dispatchPriority);
+
+    notify(dispatchSourceSnapshot_, [dispatchSource, dispatchPriority](const DispatchSourceListenerList::value_type &_listener) {
+        _listener.first(dispatchSource, dispatchPriority);
+    });
 }
 
 void MainLoopContext::deregisterDispatchSource(DispatchSource* dispatchSource) {
-    for(auto listener = dispatchSourceListeners_.begin(); listener != dispatchSourceListeners_.end(); ++listener) {
-        listener->second(dispatchSource);
-    }
+    // Released after the listeners were notified
+    std::shared_ptr<Instrumentation::Element> itsProxy;
+    std::shared_ptr<Instrumentation> itsInstrumentation = getInstrumentation();
+    if (itsInstrumentation)
+        dispatchSource = itsInstrumentation->unwrap<Instrumentation::Source>(dispatchSource, itsProxy);
+
+    notify(dispatchSourceSnapshot_, [dispatchSource](const DispatchSourceListenerList::value_type &_listener) {
+        _listener.second(dispatchSource);
+    });
 }
 
 void MainLoopContext::registerWatch(Watch* watch, const DispatchPriority dispatchPriority) {
-    for(auto listener = watchListeners_.begin(); listener != watchListeners_.end(); ++listener) {
-        listener->first(watch, dispatchPriority);
-    }
+    std::shared_ptr<Instrumentation> itsInstrumentation = getInstrumentation();
+    if (itsInstrumentation)
+        watch = itsInstrumentation->wrap<Instrumentation::WatchProxy>(watch, dispatchPriority);
+
+    notify(watchSnapshot_, [watch, dispatchPriority](const WatchListenerList::value_type &_listener) {
+        _listener.first(watch, dispatchPriority);
+    });
 }
 
 void MainLoopContext::deregisterWatch(Watch* watch) {
-    for(auto listener = watchListeners_.begin(); listener != watchListeners_.end(); ++listener) {
-        listener->second(watch);
-    }
+    // Released after the listeners were notified
+    std::shared_ptr<Instrumentation::Element> itsProxy;
+    std::shared_ptr<Instrumentation> itsInstrumentation = getInstrumentation();
+    if (itsInstrumentation)
+        watch = itsInstrumentation->unwrap<Instrumentation::WatchProxy>(watch, itsProxy);
+
+    notify(watchSnapshot_, [watch](const WatchListenerList::value_type &_listener) {
+        _listener.second(watch);
+    });
 }
 
 void MainLoopContext::registerTimeoutSource(Timeout* timeoutEvent, const DispatchPriority dispatchPriority) {
-    for(auto listener = timeoutSourceListeners_.begin(); listener != timeoutSourceListeners_.end(); ++listener) {
-        listener->first(timeoutEvent, dispatchPriority);
-    }
+    std::shared_ptr<Instrumentation> itsInstrumentation = getInstrumentation();
+    if (itsInstrumentation)
+        timeoutEvent = itsInstrumentation->wrap<Instrumentation::TimeoutProxy>(timeoutEvent, dispatchPriority);
+
+    notify(timeoutSourceSnapshot_, [timeoutEvent, dispatchPriority](const TimeoutSourceListenerList::value_type &_listener) {
+        _listener.first(timeoutEvent, dispatchPriority);
+    });
 }
 
 void MainLoopContext::deregisterTimeoutSource(Timeout* timeoutEvent) {
-    for(auto listener = timeoutSourceListeners_.begin(); listener != timeoutSourceListeners_.end(); ++listener) {
-        listener->second(timeoutEvent);
-    }
+    // Released after the listeners were notified
+    std::shared_ptr<Instrumentation::Element> itsProxy;
+    std::shared_ptr<Instrumentation> itsInstrumentation = getInstrumentation();
+    if (itsInstrumentation)
+        timeoutEvent = itsInstrumentation->unwrap<Instrumentation::TimeoutProxy>(timeoutEvent, itsProxy);
+
+    notify(timeoutSourceSnapshot_, [timeoutEvent](const TimeoutSourceListenerList::value_type &_listener) {
+        _listener.second(timeoutEvent);
+    });
 }
 
 void MainLoopContext::wakeup() {
-    for(auto listener = wakeupListeners_.begin(); listener != wakeupListeners_.end(); ++listener) {
-        (*listener)();
+    // Sequentially consistent to pair with acknowledgeWakeup: either the
+    // loop did not yet check for ready elements or the wakeup is passed on.
+    if (wakeupCoalescers_.load(std::memory_order_acquire) > 0
+            && isWakeupPending_.exchange(true)) {
+        suppressedWakeups_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    notify(wakeupSnapshot_, [](const WakeupListenerList::value_type &_listener) {
+        _listener();
+    });
+}
+
+void MainLoopContext::setWakeupCoalescing(bool _isEnabled) {
+    if (_isEnabled) {
+        if (wakeupCoalescers_.fetch_add(1, std::memory_order_acq_rel) == 0)
+            isWakeupPending_.store(false);
+        return;
+    }
+
+    uint32_t itsCoalescers = wakeupCoalescers_.load(std::memory_order_acquire);
+    while (itsCoalescers > 0
+            && !wakeupCoalescers_.compare_exchange_weak(itsCoalescers, itsCoalescers - 1,
+                                                        std::memory_order_acq_rel)) {
+    }
+}
+
+void MainLoopContext::acknowledgeWakeup() {
+    (void)isWakeupPending_.exchange(false);
+}
+
+uint64_t MainLoopContext::getSuppressedWakeups() const {
+    return suppressedWakeups_.load(std::memory_order_relaxed);
+}
+
+void MainLoopContext::enableInstrumentation() {
+    std::lock_guard<std::mutex> itsLock(listenersMutex_);
+    if (getInstrumentation())
+        return;
+
+    std::shared_ptr<Instrumentation> itsInstrumentation = std::make_shared<Instrumentation>(name_);
+    {
+        std::lock_guard<std::mutex> itsRegistryLock(Instrumentation::registryMutex__);
+        auto &itsRegistry = Instrumentation::registry__;
+        for (auto it = itsRegistry.begin(); it != itsRegistry.end(); ) {
+            if (it->second.expired())
+                it = itsRegistry.erase(it);
+            else
+                ++it;
+        }
+        itsRegistry.emplace(name_, itsInstrumentation);
     }
+    instrumentation_.emplace(std::move(itsInstrumentation));
+}
+
+std::shared_ptr<MainLoopContext::Instrumentation> MainLoopContext::getInstrumentation() const {
+    AtomicSnapshot<std::shared_ptr<Instrumentation>>::Reference itsInstrumentation(instrumentation_.load());
+    return (itsInstrumentation ? *itsInstrumentation : nullptr);
+}
+
+bool MainLoopContext::getStatistics(MainLoopStatistics &_statistics) const {
+    std::shared_ptr<Instrumentation> itsInstrumentation = getInstrumentation();
+    if (!itsInstrumentation)
+        return false;
+    itsInstrumentation->getStatistics(_statistics);
+    return true;
+}
+
+std::vector<MainLoopStatistics> MainLoopContext::getStatistics(const std::string &_name) {
+    std::vector<std::shared_ptr<Instrumentation>> itsInstrumentations;
+    {
+        std::lock_guard<std::mutex> itsLock(Instrumentation::registryMutex__);
+        auto itsRange = Instrumentation::registry__.equal_range(_name);
+        for (auto it = itsRange.first; it != itsRange.second; ++it) {
+            std::shared_ptr<Instrumentation> itsInstrumentation = it->second.lock();
+            if (itsInstrumentation)
+                itsInstrumentations.push_back(std::move(itsInstrumentation));
+        }
+    }
+
+    std::vector<MainLoopStatistics> itsStatistics(itsInstrumentations.size());
+    for (std::size_t i = 0; i < itsInstrumentations.size(); i++)
+        itsInstrumentations[i]->getStatistics(itsStatistics[i]);
+    return itsStatistics;
 }
 
 bool MainLoopContext::isInitialized() {
-    return dispatchSourceListeners_.size() > 0 || watchListeners_.size() > 0;
+    // Empty lists are not published
+    return (dispatchSourceSnapshot_.load() || watchSnapshot_.load());
 }
 
 } // namespace CommonAPI
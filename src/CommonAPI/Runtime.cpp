@@ -13,6 +13,7 @@
 #include <sys/stat.h>
 
 #include <algorithm>
+#include <thread>
 
 #include <CommonAPI/Config.hpp>
 #include <CommonAPI/Factory.hpp>
@@ -31,6 +32,9 @@ std::map<std::string, std::string> properties__;
 static std::shared_ptr<Runtime> * theRuntimePtr__;
 static std::mutex getMutex__;
 
+// Loading libraries is mostly I/O and the dynamic loader serializes most of it
+static const std::size_t MAX_PRELOAD_THREADS = 4;
+
 #ifndef _WIN32
 DEINITIALIZER(RuntimeDeinit) {
     if (theRuntimePtr__) {
@@ -80,7 +84,11 @@ Runtime::Runtime()
       defaultFolder_(COMMONAPI_DEFAULT_FOLDER),
       defaultCallTimeout_(DEFAULT_SEND_TIMEOUT),
       isConfigured_(false),
-      isInitialized_(false) {
+      isInitialized_(false),
+      isPreloading_(false),
+      isPreloadImmediate_(false),
+      nextKey_(0) {
+    factories_.emplace(std::make_shared<const Factories>());
 }
 
 Runtime::~Runtime() {
@@ -93,19 +101,19 @@ Runtime::registerFactory(const std::string &_binding, std::shared_ptr<Factory> _
 #ifndef _WIN32
     std::lock_guard<std::mutex> itsLock(factoriesMutex_);
 #endif
+    auto itsFactories = std::make_shared<Factories>(*getFactories());
     if (_binding == defaultBinding_) {
-        defaultFactory_ = _factory;
+        itsFactories->defaultFactory_ = _factory;
         isRegistered = true;
     } else {
-        auto foundFactory = factories_.find(_binding);
-        if (foundFactory == factories_.end()) {
-            factories_[_binding] = _factory;
-            isRegistered = true;
-        }
+        isRegistered = itsFactories->factories_.emplace(_binding, _factory).second;
     }
 
-    if (isRegistered && isInitialized_)
-        _factory->init();
+    if (isRegistered) {
+        if (isInitialized_)
+            _factory->init();
+        setFactories(itsFactories);
+    }
 
     return isRegistered;
 }
@@ -115,20 +123,142 @@ Runtime::unregisterFactory(const std::string &_binding) {
 #ifndef _WIN32
     std::lock_guard<std::mutex> itsLock(factoriesMutex_);
 #endif
+    auto itsFactories = std::make_shared<Factories>(*getFactories());
     if (_binding == defaultBinding_) {
-        defaultFactory_.reset();
+        itsFactories->defaultFactory_.reset();
     } else {
-        factories_.erase(_binding);
+        itsFactories->factories_.erase(_binding);
     }
+    setFactories(itsFactories);
     return true;
 }
 
+std::vector<std::future<std::shared_ptr<Proxy>>>
+Runtime::buildProxiesAsync(const std::vector<ProxyRequest> &_requests,
+                           ProxiesBuiltCallback _callback,
+                           std::shared_ptr<Executor> _executor) {
+    struct Batch {
+        std::vector<std::promise<std::shared_ptr<Proxy>>> promises_;
+        std::vector<std::shared_ptr<Proxy>> proxies_;
+        std::atomic<std::size_t> pending_;
+        ProxiesBuiltCallback callback_;
+    };
+
+    std::vector<std::future<std::shared_ptr<Proxy>>> itsFutures;
+    itsFutures.reserve(_requests.size());
+
+    auto itsBatch = std::make_shared<Batch>();
+    itsBatch->promises_.resize(_requests.size());
+    itsBatch->proxies_.resize(_requests.size());
+    itsBatch->pending_ = _requests.size();
+    itsBatch->callback_ = std::move(_callback);
+    for (auto &p : itsBatch->promises_)
+        itsFutures.push_back(p.get_future());
+
+    if (_requests.empty()) {
+        if (itsBatch->callback_)
+            itsBatch->callback_(itsBatch->proxies_);
+        return itsFutures;
+    }
+
+    // Once for all proxies, instead of racing for it by each of them
+    if (!isInitialized_)
+        initFactories();
+
+    std::shared_ptr<Runtime> itsRuntime(shared_from_this());
+    for (std::size_t i = 0; i < _requests.size(); i++) {
+        execute(_executor, [itsRuntime, itsBatch, i, _request = _requests[i]]() {
+            std::shared_ptr<Proxy> itsProxy;
+            try {
+                if (_request.context_)
+                    itsProxy = itsRuntime->createProxy(_request.domain_, _request.interface_,
+                                                       _request.instance_, _request.context_);
+                else
+                    itsProxy = itsRuntime->createProxy(_request.domain_, _request.interface_,
+                                                       _request.instance_, _request.connectionId_);
+                itsBatch->proxies_[i] = itsProxy;
+                itsBatch->promises_[i].set_value(itsProxy);
+            } catch (...) {
+                itsBatch->promises_[i].set_exception(std::current_exception());
+            }
+
+            if (itsBatch->pending_.fetch_sub(1, std::memory_order_acq_rel) == 1
+                    && itsBatch->callback_)
+                itsBatch->callback_(itsBatch->proxies_);
+        });
+    }
+
+    return itsFutures;
+}
+
+std::shared_future<void>
+Runtime::preloadLibraries(bool _isImmediate) {
+    struct Preload {
+        std::promise<void> promise_;
+        std::atomic<std::size_t> pending_;
+        std::unique_ptr<ThreadPoolExecutor> executor_;
+    };
+
+    std::set<std::string> itsLibraries;
+    for (auto &l : libraries_)
+        for (auto &m : l.second)
+            itsLibraries.insert(m.second);
+
+    auto itsPreload = std::make_shared<Preload>();
+    itsPreload->pending_ = itsLibraries.size();
+    std::shared_future<void> itsFuture = itsPreload->promise_.get_future().share();
+    {
+        std::lock_guard<std::mutex> itsLock(executorMutex_);
+        preload_ = itsFuture;
+    }
+
+    if (itsLibraries.empty()) {
+        itsPreload->promise_.set_value();
+        return itsFuture;
+    }
+
+    COMMONAPI_INFO("Preloading ", itsLibraries.size(), " interface libraries");
+    std::size_t itsThreads = std::min({ itsLibraries.size(), MAX_PRELOAD_THREADS,
+                                        std::max<std::size_t>(std::thread::hardware_concurrency(), 1) });
+    itsPreload->executor_.reset(new ThreadPoolExecutor(itsThreads));
+
+    // The last task releases the pool, which lets the worker that runs it
+    // finish by itself
+    ThreadPoolExecutor &itsExecutor = *itsPreload->executor_;
+    std::shared_ptr<Runtime> itsRuntime(shared_from_this());
+    std::size_t itsKey(0);
+    for (auto &l : itsLibraries) {
+        itsExecutor.execute(itsKey++, [itsRuntime, itsPreload, l, _isImmediate]() {
+            if (!itsRuntime->loadLibrary(l, _isImmediate))
+                COMMONAPI_WARNING("Preloading interface library \"", l, "\" failed.");
+
+            if (itsPreload->pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::unique_ptr<ThreadPoolExecutor> itsFinished(std::move(itsPreload->executor_));
+                itsPreload->promise_.set_value();
+            }
+        });
+    }
+
+    return itsFuture;
+}
+
+void
+Runtime::waitForPreload() {
+    std::shared_future<void> itsPreload;
+    {
+        std::lock_guard<std::mutex> itsLock(executorMutex_);
+        itsPreload = preload_;
+    }
+    if (itsPreload.valid())
+        itsPreload.wait();
+}
+
 /*
  * Private
  */
 void Runtime::init() {
 #ifndef _WIN32
-    std::lock_guard<std::mutex> itsLock(mutex_);
+    std::unique_lock<std::mutex> itsLock(mutex_);
 #endif
     if (!isConfigured_) {
         // Determine default configuration file
@@ -154,6 +284,13 @@ void Runtime::init() {
             defaultFolder_ = folder;
 
         isConfigured_ = true;
+
+        // Not under the lock, loading a library may call back into the runtime
+#ifndef _WIN32
+        itsLock.unlock();
+#endif
+        if (isPreloading_)
+            (void)preloadLibraries(isPreloadImmediate_);
     }
 }
 
@@ -165,10 +302,11 @@ Runtime::initFactories() {
         COMMONAPI_INFO("Using default binding \'", defaultBinding_, "\'");
         COMMONAPI_INFO("Using default shared library folder \'", defaultFolder_, "\'");
 
-        if (defaultFactory_)
-            defaultFactory_->init();
+        auto itsFactories = getFactories();
+        if (itsFactories->defaultFactory_)
+            itsFactories->defaultFactory_->init();
 
-        for (auto f : factories_)
+        for (auto f : itsFactories->factories_)
             f.second->init();
 
         isInitialized_ = true;
@@ -236,6 +374,11 @@ Runtime::readConfiguration() {
         if ("" != callTimeout) {
             defaultCallTimeout_ = std::stoi(callTimeout);
         }
+        std::string preload = section->getValue("preload");
+        if ("true" == preload || "now" == preload) {
+            isPreloading_ = true;
+            isPreloadImmediate_ = ("now" == preload);
+        }
     }
 
     section = reader.getSection("proxy");
@@ -257,58 +400,97 @@ Runtime::readConfiguration() {
     return true;
 }
 
-std::shared_ptr<Proxy>
-Runtime::createProxy(
-        const std::string &_domain, const std::string &_interface, const std::string &_instance,
-        const ConnectionId_t &_connectionId) {
+template<typename Result_, typename Create_>
+Result_
+Runtime::create(const std::string &_domain, const std::string &_interface, const std::string &_instance,
+                bool _isProxy, Create_ _create) {
     if (!isInitialized_) {
         initFactories();
     }
 
-    // Check whether we already know how to create such proxies...
-    std::shared_ptr<Proxy> proxy = createProxyHelper(_domain, _interface, _instance, _connectionId, false);
-    if (!proxy) {
-        // ...it seems do not, lets try to load a library that does...
-        std::lock_guard<std::mutex> itsGuard(loadMutex_);
-        std::string library = getLibrary(_domain, _interface, _instance, true);
-        bool libraryLoaded = loadLibrary(library);
+    auto itsFactories = getFactories();
+    auto itsResolution = resolve(*itsFactories, _domain, _interface, _instance, _isProxy);
 
-        if (libraryLoaded || defaultFactory_) {
-            if(!libraryLoaded){
-                COMMONAPI_DEBUG("Loading interface library failed, using default factory now.");
-            }
-            proxy = createProxyHelper(_domain, _interface, _instance, _connectionId, true);
+    // The factory that succeeded the last time is the most likely to succeed again...
+    if (itsResolution->factory_) {
+        Result_ itsResult = _create(*itsResolution->factory_);
+        if (itsResult)
+            return itsResult;
+    }
+
+    // ...otherwise check whether we already know how to create it...
+    for (auto &f : itsFactories->factories_) {
+        if (f.second == itsResolution->factory_)
+            continue;
+        Result_ itsResult = _create(*f.second);
+        if (itsResult) {
+            remember(*itsFactories, itsResolution, f.second, itsResolution->isLoaded_);
+            return itsResult;
         }
     }
-    return proxy;
-}
 
-std::shared_ptr<Proxy>
-Runtime::createProxy(
-        const std::string &_domain, const std::string &_interface, const std::string &_instance,
-        std::shared_ptr<MainLoopContext> _context) {
-    if (!isInitialized_) {
-        initFactories();
+    // ...it seems we do not, lets try to load a library that does...
+    bool libraryLoaded(itsResolution->isLoaded_);
+    if (!libraryLoaded) {
+        libraryLoaded = loadLibrary(itsResolution->library_);
     }
 
-    // Check whether we already know how to create such proxies...
-    std::shared_ptr<Proxy> proxy = createProxyHelper(_domain, _interface, _instance, _context, false);
-    if (!proxy) {
-        // ...it seems do not, lets try to load a library that does...
-        std::lock_guard<std::mutex> itsGuard(loadMutex_);
-        std::string library = getLibrary(_domain, _interface, _instance, true);
-        bool libraryLoaded = loadLibrary(library);
+    // ...which may have registered further factories or, more likely,
+    // added creators to the known ones, thus all are asked again
+    auto itsLoadedFactories = getFactories();
+    if (!libraryLoaded && !itsLoadedFactories->defaultFactory_)
+        return Result_();
+
+    if (!libraryLoaded) {
+        COMMONAPI_DEBUG("Loading interface library failed, using default factory now.");
+    }
+
+    bool hasNewFactories(itsLoadedFactories != itsFactories);
+    if (hasNewFactories) {
+        itsFactories = itsLoadedFactories;
+        itsResolution = resolve(*itsFactories, _domain, _interface, _instance, _isProxy);
+    }
 
-        if (libraryLoaded || defaultFactory_) {
-            if(!libraryLoaded){
-                COMMONAPI_DEBUG("Loading interface library failed, using default factory now.");
+    if (libraryLoaded || hasNewFactories) {
+        for (auto &f : itsFactories->factories_) {
+            Result_ itsResult = _create(*f.second);
+            if (itsResult) {
+                remember(*itsFactories, itsResolution, f.second, libraryLoaded);
+                return itsResult;
             }
-            proxy = createProxyHelper(_domain, _interface, _instance, _context, true);
         }
     }
-    return proxy;
+
+    std::shared_ptr<Factory> itsFactory;
+    Result_ itsResult = Result_();
+    if (itsFactories->defaultFactory_ && itsFactories->defaultFactory_ != itsResolution->factory_) {
+        itsResult = _create(*itsFactories->defaultFactory_);
+        if (itsResult)
+            itsFactory = itsFactories->defaultFactory_;
+    }
+    remember(*itsFactories, itsResolution, itsFactory, libraryLoaded);
+    return itsResult;
+}
+
+std::shared_ptr<Proxy>
+Runtime::createProxy(
+        const std::string &_domain, const std::string &_interface, const std::string &_instance,
+        const ConnectionId_t &_connectionId) {
+    return create<std::shared_ptr<Proxy>>(_domain, _interface, _instance, true,
+        [&](Factory &_factory) {
+            return _factory.createProxy(_domain, _interface, _instance, _connectionId);
+        });
 }
 
+std::shared_ptr<Proxy>
+Runtime::createProxy(
+        const std::string &_domain, const std::string &_interface, const std::string &_instance,
+        std::shared_ptr<MainLoopContext> _context) {
+    return create<std::shared_ptr<Proxy>>(_domain, _interface, _instance, true,
+        [&](Factory &_factory) {
+            return _factory.createProxy(_domain, _interface, _instance, _context);
+        });
+}
 
 bool
 Runtime::registerStub(const std::string &_domain, const std::string &_interface, const std::string &_instance,
@@ -317,24 +499,10 @@ Runtime::registerStub(const std::string &_domain, const std::string &_interface,
         return false;
     }
 
-    if (!isInitialized_) {
-        initFactories();
-    }
-
-    bool isRegistered = registerStubHelper(_domain, _interface, _instance, _stub, _connectionId, false);
-    if (!isRegistered) {
-        std::string library = getLibrary(_domain, _interface, _instance, false);
-        std::lock_guard<std::mutex> itsGuard(loadMutex_);
-        bool libraryLoaded = loadLibrary(library);
-
-        if (libraryLoaded || defaultFactory_) {
-            if(!libraryLoaded){
-                COMMONAPI_DEBUG("Loading interface library failed, using default factory now.");
-            }
-            isRegistered = registerStubHelper(_domain, _interface, _instance, _stub, _connectionId, true);
-        }
-    }
-    return isRegistered;
+    return create<bool>(_domain, _interface, _instance, false,
+        [&](Factory &_factory) {
+            return _factory.registerStub(_domain, _interface, _instance, _stub, _connectionId);
+        });
 }
 
 bool
@@ -344,34 +512,22 @@ Runtime::registerStub(const std::string &_domain, const std::string &_interface,
         return false;
     }
 
-    if (!isInitialized_) {
-        initFactories();
-    }
-
-    bool isRegistered = registerStubHelper(_domain, _interface, _instance, _stub, _context, false);
-    if (!isRegistered) {
-        std::string library = getLibrary(_domain, _interface, _instance, false);
-        std::lock_guard<std::mutex> itsGuard(loadMutex_);
-        bool libraryLoaded = loadLibrary(library);
-
-        if (libraryLoaded || defaultFactory_) {
-            if(!libraryLoaded){
-                COMMONAPI_DEBUG("Loading interface library failed, using default factory now.");
-            }
-            isRegistered = registerStubHelper(_domain, _interface, _instance, _stub, _context, true);
-        }
-    }
-    return isRegistered;
+    return create<bool>(_domain, _interface, _instance, false,
+        [&](Factory &_factory) {
+            return _factory.registerStub(_domain, _interface, _instance, _stub, _context);
+        });
 }
 
 bool
 Runtime::unregisterStub(const std::string &_domain, const std::string &_interface, const std::string &_instance) {
-    for (auto factory : factories_) {
+    auto itsFactories = getFactories();
+    for (auto factory : itsFactories->factories_) {
         if (factory.second->unregisterStub(_domain, _interface, _instance))
             return true;
     }
 
-    return (defaultFactory_ ? defaultFactory_->unregisterStub(_domain, _interface, _instance) : false);
+    return (itsFactories->defaultFactory_ ?
+                itsFactories->defaultFactory_->unregisterStub(_domain, _interface, _instance) : false);
 }
 
 std::string
@@ -412,7 +568,7 @@ Runtime::getLibrary(
 }
 
 bool
-Runtime::loadLibrary(const std::string &_library) {
+Runtime::loadLibrary(const std::string &_library, bool _isImmediate) {
     std::string itsLibrary(_library);
 
     // TODO: decide whether this really is a good idea...
@@ -446,88 +602,137 @@ Runtime::loadLibrary(const std::string &_library) {
     }
     #endif
 
+    {
+        std::lock_guard<std::mutex> itsGuard(loadMutex_);
+        if (loadedLibraries_.end() != loadedLibraries_.find(itsLibrary))
+            return true;
+    }
+
+    // Not locked, so libraries are loaded in parallel. Loading a library
+    // twice only increases its reference count.
     bool isLoaded(true);
-    if (loadedLibraries_.end() == loadedLibraries_.find(itsLibrary)) {
-        #ifdef _WIN32
-        if (LoadLibrary(itsLibrary.c_str()) != 0) {
-            loadedLibraries_.insert(itsLibrary);
-            COMMONAPI_DEBUG("Loading interface library \"", itsLibrary, "\" succeeded.");
-        } else {
-            COMMONAPI_DEBUG("Loading interface library \"", itsLibrary, "\" failed (", GetLastError(), ")");
-            isLoaded = false;
-        }
-        #else
-        if (dlopen(itsLibrary.c_str(), RTLD_LAZY | RTLD_GLOBAL) != NULL) {
-            loadedLibraries_.insert(itsLibrary);
-            COMMONAPI_DEBUG("Loading interface library \"", itsLibrary, "\" succeeded.");
-        }
-        else {
-            COMMONAPI_DEBUG("Loading interface library \"", itsLibrary, "\" failed (", dlerror(), ")");
-            isLoaded = false;
-        }
-        #endif
+    #ifdef _WIN32
+    (void)_isImmediate;
+    if (LoadLibrary(itsLibrary.c_str()) != 0) {
+        COMMONAPI_DEBUG("Loading interface library \"", itsLibrary, "\" succeeded.");
+    } else {
+        COMMONAPI_DEBUG("Loading interface library \"", itsLibrary, "\" failed (", GetLastError(), ")");
+        isLoaded = false;
+    }
+    #else
+    if (dlopen(itsLibrary.c_str(), (_isImmediate ? RTLD_NOW : RTLD_LAZY) | RTLD_GLOBAL) != NULL) {
+        COMMONAPI_DEBUG("Loading interface library \"", itsLibrary, "\" succeeded.");
+    }
+    else {
+        COMMONAPI_DEBUG("Loading interface library \"", itsLibrary, "\" failed (", dlerror(), ")");
+        isLoaded = false;
+    }
+    #endif
+
+    if (isLoaded) {
+        std::lock_guard<std::mutex> itsGuard(loadMutex_);
+        loadedLibraries_.insert(itsLibrary);
     }
     return isLoaded;
 }
 
-std::shared_ptr<Proxy>
-Runtime::createProxyHelper(const std::string &_domain, const std::string &_interface, const std::string &_instance,
-                           const std::string &_connectionId, bool _useDefault) {
-    std::lock_guard<std::mutex> itsLock(factoriesMutex_);
-    for (auto factory : factories_) {
-        std::shared_ptr<Proxy> proxy
-            = factory.second->createProxy(_domain, _interface, _instance, _connectionId);
-        if (proxy)
-            return proxy;
-    }
-    return (_useDefault && defaultFactory_ ?
-                defaultFactory_->createProxy(_domain, _interface, _instance, _connectionId)
-                : nullptr);
+std::shared_ptr<const Runtime::Factories>
+Runtime::getFactories() const {
+    return *factories_.load();
 }
 
-std::shared_ptr<Proxy>
-Runtime::createProxyHelper(const std::string &_domain, const std::string &_interface, const std::string &_instance,
-                           std::shared_ptr<MainLoopContext> _context, bool _useDefault) {
-    std::lock_guard<std::mutex> itsLock(factoriesMutex_);
-    for (auto factory : factories_) {
-        std::shared_ptr<Proxy> proxy
-            = factory.second->createProxy(_domain, _interface, _instance, _context);
-        if (proxy)
-            return proxy;
-    }
-    return (_useDefault && defaultFactory_ ?
-                defaultFactory_->createProxy(_domain, _interface, _instance, _context) :
-                nullptr);
+void
+Runtime::setFactories(std::shared_ptr<const Factories> _factories) {
+    factories_.emplace(std::move(_factories));
 }
 
-bool
-Runtime::registerStubHelper(const std::string &_domain, const std::string &_interface, const std::string &_instance,
-                            std::shared_ptr<StubBase> _stub, const std::string &_connectionId, bool _useDefault) {
-    bool isRegistered(false);
-    std::lock_guard<std::mutex> itsLock(factoriesMutex_);
-    for (auto factory : factories_) {
-        isRegistered = factory.second->registerStub(_domain, _interface, _instance, _stub, _connectionId);
-        if (isRegistered)
-            return isRegistered;
-    }
-    return (_useDefault && defaultFactory_ ?
-                defaultFactory_->registerStub(_domain, _interface, _instance, _stub, _connectionId) :
-                false);
+std::shared_ptr<const Runtime::Resolution>
+Runtime::resolve(const Factories &_factories,
+                 const std::string &_domain, const std::string &_interface, const std::string &_instance,
+                 bool _isProxy) {
+    // Not keyed by InternedAddress: the callers only have the strings, and
+    // interning them looks up each of them in the process wide table under
+    // its lock, which costs more than hashing and comparing them here.
+    std::hash<std::string> itsHasher;
+    std::size_t itsHash = itsHasher(_domain);
+    itsHash = itsHash * 31 + itsHasher(_interface);
+    itsHash = itsHash * 31 + itsHasher(_instance);
+    itsHash = itsHash * 2 + (_isProxy ? 1 : 0);
+
+    auto find = [&]() -> std::shared_ptr<const Resolution> {
+        auto itsRange = _factories.resolutions_.equal_range(itsHash);
+        for (auto r = itsRange.first; r != itsRange.second; ++r) {
+            const Resolution &itsResolution = *r->second;
+            if (itsResolution.isProxy_ == _isProxy
+                    && itsResolution.instance_ == _instance
+                    && itsResolution.interface_ == _interface
+                    && itsResolution.domain_ == _domain)
+                return r->second;
+        }
+        return nullptr;
+    };
+
+    {
+        std::shared_lock<std::shared_mutex> itsLock(_factories.resolutionsMutex_);
+        auto itsResolution = find();
+        if (itsResolution)
+            return itsResolution;
+    }
+
+    auto itsResolution = std::make_shared<Resolution>();
+    itsResolution->hash_ = itsHash;
+    itsResolution->domain_ = _domain;
+    itsResolution->interface_ = _interface;
+    itsResolution->instance_ = _instance;
+    itsResolution->isProxy_ = _isProxy;
+    itsResolution->library_ = getLibrary(_domain, _interface, _instance, _isProxy);
+    itsResolution->isLoaded_ = false;
+
+    std::unique_lock<std::shared_mutex> itsLock(_factories.resolutionsMutex_);
+    auto itsKnownResolution = find();
+    if (itsKnownResolution)
+        return itsKnownResolution;
+    _factories.resolutions_.emplace(itsHash, itsResolution);
+    return itsResolution;
 }
 
-bool
-Runtime::registerStubHelper(const std::string &_domain, const std::string &_interface, const std::string &_instance,
-                            std::shared_ptr<StubBase> _stub, std::shared_ptr<MainLoopContext> _context, bool _useDefault) {
-    bool isRegistered(false);
-    std::lock_guard<std::mutex> itsLock(factoriesMutex_);
-    for (auto factory : factories_) {
-        isRegistered = factory.second->registerStub(_domain, _interface, _instance, _stub, _context);
-        if (isRegistered)
-            return isRegistered;
-    }
-    return (_useDefault && defaultFactory_ ?
-                defaultFactory_->registerStub(_domain, _interface, _instance, _stub, _context) :
-                false);
+void
+Runtime::remember(const Factories &_factories, const std::shared_ptr<const Resolution> &_resolution,
+                  std::shared_ptr<Factory> _factory, bool _isLoaded) {
+    if (_resolution->factory_ == _factory && _resolution->isLoaded_ == _isLoaded)
+        return;
+
+    auto itsResolution = std::make_shared<Resolution>(*_resolution);
+    itsResolution->factory_ = _factory;
+    itsResolution->isLoaded_ = _isLoaded;
+
+    std::unique_lock<std::shared_mutex> itsLock(_factories.resolutionsMutex_);
+    auto itsRange = _factories.resolutions_.equal_range(_resolution->hash_);
+    for (auto r = itsRange.first; r != itsRange.second; ++r) {
+        if (r->second == _resolution) {
+            r->second = itsResolution;
+            break;
+        }
+    }
+}
+
+void
+Runtime::execute(std::shared_ptr<Executor> _executor, Executor::Task _task) {
+    // Spread the tasks over the workers
+    std::size_t itsKey = nextKey_.fetch_add(1, std::memory_order_relaxed);
+    if (_executor) {
+        _executor->execute(itsKey, std::move(_task));
+        return;
+    }
+
+    ThreadPoolExecutor *itsExecutor;
+    {
+        std::lock_guard<std::mutex> itsLock(executorMutex_);
+        if (!executor_)
+            executor_.reset(new ThreadPoolExecutor());
+        itsExecutor = executor_.get();
+    }
+    itsExecutor->execute(itsKey, std::move(_task));
 }
 
 Timeout_t Runtime::getDefaultCallTimeout() const {
@@ -0,0 +1,254 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef _WIN32
+
+#include <poll.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <CommonAPI/Logger.hpp>
+#include <CommonAPI/SimulatedMainLoop.hpp>
+
+namespace CommonAPI {
+
+namespace {
+
+template<typename Pointer_>
+const Pointer_ &checkNotNull(const Pointer_ &_pointer, const char *_name) {
+    if (!_pointer)
+        throw std::invalid_argument(std::string("SimulatedMainLoop: no ") + _name);
+    return _pointer;
+}
+
+} // anonymous namespace
+
+SimulatedMainLoop::SimulatedMainLoop(std::shared_ptr<MainLoopContext> _context,
+                                     std::shared_ptr<SimulatedClock> _clock)
+    : context_(checkNotNull(_context, "context")),
+      clock_(checkNotNull(_clock, "clock")),
+      timeouts_(_clock->getCurrentTimeInNs() / 1000000),
+      isTracing_(false) {
+    sourceSubscription_ = context_->subscribeForDispatchSources(
+        [this](DispatchSource *_source, const DispatchPriority _priority) {
+            std::lock_guard<std::mutex> itsLock(mutex_);
+            sources_.emplace(_source, std::make_shared<Entry>(_source, _priority));
+        },
+        [this](DispatchSource *_source) {
+            std::lock_guard<std::mutex> itsLock(mutex_);
+            auto itsSource = sources_.find(_source);
+            if (itsSource != sources_.end()) {
+                itsSource->second->isActive_ = false;
+                sources_.erase(itsSource);
+            }
+        });
+    watchSubscription_ = context_->subscribeForWatches(
+        [this](Watch *_watch, const DispatchPriority _priority) {
+            std::lock_guard<std::mutex> itsLock(mutex_);
+            watches_.emplace(_watch, std::make_shared<Entry>(_watch, _priority));
+        },
+        [this](Watch *_watch) {
+            std::lock_guard<std::mutex> itsLock(mutex_);
+            auto itsWatch = watches_.find(_watch);
+            if (itsWatch != watches_.end()) {
+                itsWatch->second->isActive_ = false;
+                watches_.erase(itsWatch);
+            }
+        });
+    timeoutSubscription_ = context_->subscribeForTimeouts(
+        [this](Timeout *_timeout, const DispatchPriority _priority) {
+            // Registering a known timeout reschedules it
+            std::lock_guard<std::mutex> itsLock(mutex_);
+            timeouts_.add(_timeout, _priority);
+        },
+        [this](Timeout *_timeout) {
+            deregisterTimeout(_timeout);
+        });
+}
+
+SimulatedMainLoop::~SimulatedMainLoop() {
+    context_->unsubscribeForDispatchSources(sourceSubscription_);
+    context_->unsubscribeForWatches(watchSubscription_);
+    context_->unsubscribeForTimeouts(timeoutSubscription_);
+}
+
+void
+SimulatedMainLoop::deregisterTimeout(Timeout *_timeout) {
+    std::lock_guard<std::mutex> itsLock(mutex_);
+    timeouts_.remove(_timeout);
+}
+
+std::size_t
+SimulatedMainLoop::runPending() {
+    std::size_t itsCount(0);
+    for (std::size_t r = 0; r < MAX_ROUNDS; r++) {
+        ReadyList itsReady[NUMBER_OF_PRIORITIES];
+        if (!collect(itsReady))
+            break;
+        itsCount += dispatch(itsReady);
+    }
+    return itsCount;
+}
+
+std::size_t
+SimulatedMainLoop::runUntil(int64_t _time) {
+    std::size_t itsCount(runPending());
+    while (true) {
+        int64_t itsNext;
+        {
+            std::lock_guard<std::mutex> itsLock(mutex_);
+            itsNext = timeouts_.getNextReadyTime();
+        }
+        int64_t itsNow = clock_->getCurrentTimeInNs() / 1000000;
+        if (itsNext > _time || itsNow >= _time)
+            break;
+
+        // Exact for due timeouts, a lower bound for far ones,
+        // which are moved closer to their point in time. A Timeout
+        // that is still due must not stop the time.
+        clock_->setCurrentTimeInNs(std::max(itsNext, itsNow + 1) * 1000000);
+        itsCount += runPending();
+    }
+    clock_->setCurrentTimeInNs(_time * 1000000);
+    itsCount += runPending();
+    return itsCount;
+}
+
+std::size_t
+SimulatedMainLoop::runFor(std::chrono::milliseconds _duration) {
+    return runUntil(clock_->getCurrentTimeInNs() / 1000000 + _duration.count());
+}
+
+void
+SimulatedMainLoop::setTimeoutPolling(bool _isEnabled) {
+    timeouts_.setPolling(_isEnabled);
+}
+
+void
+SimulatedMainLoop::setTracing(bool _isEnabled) {
+    std::lock_guard<std::mutex> itsLock(mutex_);
+    isTracing_ = _isEnabled;
+}
+
+std::vector<SimulatedDispatch>
+SimulatedMainLoop::getTrace() const {
+    std::lock_guard<std::mutex> itsLock(mutex_);
+    return trace_;
+}
+
+void
+SimulatedMainLoop::clearTrace() {
+    std::lock_guard<std::mutex> itsLock(mutex_);
+    trace_.clear();
+}
+
+bool
+SimulatedMainLoop::collect(ReadyList *_ready) {
+    bool isReady(false);
+    int64_t itsNow = clock_->getCurrentTimeInNs() / 1000000;
+
+    std::vector<std::shared_ptr<Entry>> itsSources;
+    std::vector<std::shared_ptr<Entry>> itsWatches;
+    {
+        std::lock_guard<std::mutex> itsLock(mutex_);
+
+        // Timeouts that do not register again if their ready time moves to
+        // an earlier point in time
+        timeouts_.poll();
+        timeouts_.collect(itsNow, [_ready, &isReady](const std::shared_ptr<ScheduledTimeout> &_entry) {
+            _ready[static_cast<std::size_t>(_entry->priority_)].timeouts_.push_back(_entry);
+            isReady = true;
+        });
+
+        for (auto &s : sources_)
+            itsSources.push_back(s.second);
+        for (auto &w : watches_)
+            itsWatches.push_back(w.second);
+    }
+
+    for (auto &s : itsSources) {
+        DispatchSource *itsSource = static_cast<DispatchSource *>(s->element_);
+        int64_t itsTimeout(TIMEOUT_INFINITE);
+        if (itsSource->prepare(itsTimeout) || itsSource->check()) {
+            _ready[static_cast<std::size_t>(s->priority_)].sources_.push_back(s);
+            isReady = true;
+        }
+    }
+
+    if (!itsWatches.empty()) {
+        std::vector<pollfd> itsFileDescriptors;
+        itsFileDescriptors.reserve(itsWatches.size());
+        for (auto &w : itsWatches) {
+            pollfd itsFileDescriptor = static_cast<Watch *>(w->element_)->getAssociatedFileDescriptor();
+            itsFileDescriptor.revents = 0;
+            itsFileDescriptors.push_back(itsFileDescriptor);
+        }
+
+        if (poll(itsFileDescriptors.data(), itsFileDescriptors.size(), 0) < 0) {
+            if (errno != EINTR)
+                COMMONAPI_ERROR("SimulatedMainLoop: poll failed: ", std::strerror(errno));
+        } else {
+            for (std::size_t i = 0; i < itsWatches.size(); i++) {
+                if (itsFileDescriptors[i].revents) {
+                    _ready[static_cast<std::size_t>(itsWatches[i]->priority_)].watches_.push_back(
+                        { itsWatches[i], static_cast<unsigned int>(itsFileDescriptors[i].revents) });
+                    isReady = true;
+                }
+            }
+        }
+    }
+
+    return isReady;
+}
+
+std::size_t
+SimulatedMainLoop::dispatch(ReadyList *_ready) {
+    std::size_t itsCount(0);
+    for (std::size_t p = 0; p < NUMBER_OF_PRIORITIES; p++) {
+        for (auto &t : _ready[p].timeouts_) {
+            if (!t->isActive_)
+                continue;
+            trace(DispatchStatistics::Kind::TIMEOUT, t->timeout_);
+            if (!t->timeout_->dispatch())
+                deregisterTimeout(t->timeout_);
+
+            std::lock_guard<std::mutex> itsLock(mutex_);
+            timeouts_.reschedule(t);
+            itsCount++;
+        }
+        for (auto &w : _ready[p].watches_) {
+            if (!w.entry_->isActive_)
+                continue;
+            Watch *itsWatch = static_cast<Watch *>(w.entry_->element_);
+            trace(DispatchStatistics::Kind::WATCH, itsWatch);
+            itsWatch->dispatch(w.events_);
+            itsCount++;
+        }
+        for (auto &s : _ready[p].sources_) {
+            if (!s->isActive_)
+                continue;
+            DispatchSource *itsSource = static_cast<DispatchSource *>(s->element_);
+            trace(DispatchStatistics::Kind::DISPATCH_SOURCE, itsSource);
+            (void)itsSource->dispatch();
+            itsCount++;
+        }
+    }
+    return itsCount;
+}
+
+void
+SimulatedMainLoop::trace(DispatchStatistics::Kind _kind, const void *_element) {
+    std::lock_guard<std::mutex> itsLock(mutex_);
+    if (isTracing_)
+        trace_.push_back({ clock_->getCurrentTimeInNs(), _kind, _element });
+}
+
+
+} // namespace CommonAPI
+
+#endif // !_WIN32
@@ -0,0 +1,179 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CommonAPI/CommonAPI.hpp>
+#include <CommonAPI/Extensions/AttributeThrottleExtension.hpp>
+
+namespace {
+
+class TestEvent : public CommonAPI::Event<int> {
+public:
+    using CommonAPI::Event<int>::notifyListeners;
+    using CommonAPI::Event<int>::getSubscriptionCount;
+};
+
+class TestAttribute : public CommonAPI::ObservableReadonlyAttribute<int> {
+public:
+    void getValue(CommonAPI::CallStatus &_status, int &_value,
+                  const CommonAPI::CallInfo *_info = nullptr) const {
+        (void)_info;
+        _status = CommonAPI::CallStatus::SUCCESS;
+        _value = 0;
+    }
+
+    std::future<CommonAPI::CallStatus> getValueAsync(AttributeAsyncCallback _callback,
+                                                     const CommonAPI::CallInfo *_info = nullptr) {
+        (void)_info;
+        _callback(CommonAPI::CallStatus::SUCCESS, 0);
+        std::promise<CommonAPI::CallStatus> itsPromise;
+        itsPromise.set_value(CommonAPI::CallStatus::SUCCESS);
+        return itsPromise.get_future();
+    }
+
+    ChangedEvent &getChangedEvent() {
+        return event_;
+    }
+
+    TestEvent event_;
+};
+
+typedef CommonAPI::Extensions::AttributeThrottleExtension<TestAttribute> Extension;
+
+// A delivered value and its simulated time
+typedef std::pair<int, int64_t> Delivery;
+
+} // namespace
+
+class AttributeThrottleExtensionTest : public ::testing::Test {
+protected:
+    void SetUp() {
+        clock_ = std::make_shared<CommonAPI::SimulatedClock>(START);
+        CommonAPI::setClock(clock_);
+        context_ = std::make_shared<CommonAPI::MainLoopContext>("AttributeThrottleExtensionTest");
+        loop_.reset(new CommonAPI::SimulatedMainLoop(context_, clock_));
+    }
+
+    void TearDown() {
+        loop_.reset();
+        CommonAPI::setClock(nullptr);
+    }
+
+    Extension::Listener record() {
+        return [this](const int &_value) {
+            deliveries_.emplace_back(_value, CommonAPI::getCurrentTimeInMs());
+        };
+    }
+
+    // Advances the time and notifies the value
+    void change(int64_t _time, int _value) {
+        if (loop_)
+            loop_->runUntil(_time);
+        else
+            clock_->setCurrentTimeInNs(_time * 1000000);
+        attribute_.event_.notifyListeners(_value);
+    }
+
+    static constexpr int64_t START = 1000;
+    static constexpr int64_t INTERVAL = 100;
+
+    std::shared_ptr<CommonAPI::SimulatedClock> clock_;
+    std::shared_ptr<CommonAPI::MainLoopContext> context_;
+    std::unique_ptr<CommonAPI::SimulatedMainLoop> loop_;
+    TestAttribute attribute_;
+    std::vector<Delivery> deliveries_;
+};
+
+TEST_F(AttributeThrottleExtensionTest, FirstChangeIsDeliveredImmediately) {
+    Extension itsExtension(attribute_, context_);
+    itsExtension.subscribeThrottled(record(), std::chrono::milliseconds(INTERVAL));
+
+    attribute_.event_.notifyListeners(1);
+    EXPECT_EQ((std::vector<Delivery>{ { 1, START } }), deliveries_);
+}
+
+TEST_F(AttributeThrottleExtensionTest, ChangesWithinTheIntervalAreCoalesced) {
+    Extension itsExtension(attribute_, context_);
+    itsExtension.subscribeThrottled(record(), std::chrono::milliseconds(INTERVAL));
+
+    change(START, 1);
+    change(START + 10, 2);
+    change(START + 20, 3);
+    loop_->runUntil(START + INTERVAL - 1);
+    EXPECT_EQ(1u, deliveries_.size());
+
+    // Newest value at the trailing edge
+    loop_->runUntil(START + INTERVAL);
+    EXPECT_EQ((std::vector<Delivery>{ { 1, START }, { 3, START + INTERVAL } }), deliveries_);
+
+    // Again after the Timeout was idle
+    change(START + 250, 4);
+    change(START + 260, 5);
+    change(START + 270, 6);
+    loop_->runUntil(START + 1000);
+    EXPECT_EQ((std::vector<Delivery>{ { 1, START }, { 3, START + INTERVAL },
+                                      { 4, START + 250 }, { 6, START + 350 } }), deliveries_);
+}
+
+TEST_F(AttributeThrottleExtensionTest, NothingIsDeliveredAfterUnsubscribe) {
+    Extension itsExtension(attribute_, context_);
+    auto itsSubscription = itsExtension.subscribeThrottled(record(), std::chrono::milliseconds(INTERVAL));
+
+    change(START, 1);
+    change(START + 10, 2);
+    itsExtension.unsubscribeThrottled(itsSubscription);
+    EXPECT_EQ(0u, attribute_.event_.getSubscriptionCount());
+
+    change(START + 500, 3);
+    loop_->runUntil(START + 1000);
+    EXPECT_EQ((std::vector<Delivery>{ { 1, START } }), deliveries_);
+}
+
+TEST_F(AttributeThrottleExtensionTest, NothingIsDeliveredAfterDestruction) {
+    std::unique_ptr<Extension> itsExtension(new Extension(attribute_, context_));
+    itsExtension->subscribeThrottled(record(), std::chrono::milliseconds(INTERVAL));
+
+    change(START, 1);
+    change(START + 10, 2);
+    itsExtension.reset();
+    EXPECT_EQ(0u, attribute_.event_.getSubscriptionCount());
+
+    loop_->runUntil(START + 1000);
+    EXPECT_EQ((std::vector<Delivery>{ { 1, START } }), deliveries_);
+}
+
+TEST_F(AttributeThrottleExtensionTest, ChangesWithinTheIntervalAreDroppedWithoutContext) {
+    Extension itsExtension(attribute_);
+    itsExtension.subscribeThrottled(record(), std::chrono::milliseconds(INTERVAL));
+
+    change(START, 1);
+    change(START + 10, 2);
+    change(START + 50, 3);
+    loop_->runUntil(START + 500);
+    change(START + 600, 4);
+    EXPECT_EQ((std::vector<Delivery>{ { 1, START }, { 4, START + 600 } }), deliveries_);
+}
+
+TEST_F(AttributeThrottleExtensionTest, HeldBackValueIsDroppedOnceTheContextIsGone) {
+    loop_.reset();
+    Extension itsExtension(attribute_, context_);
+    itsExtension.subscribeThrottled(record(), std::chrono::milliseconds(INTERVAL));
+
+    change(START, 1);
+    change(START + 10, 2);
+    context_.reset();
+
+    clock_->advance(std::chrono::milliseconds(200));
+    attribute_.event_.notifyListeners(3);
+    EXPECT_EQ((std::vector<Delivery>{ { 1, START }, { 3, START + 210 } }), deliveries_);
+}
@@ -0,0 +1,426 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CommonAPI/CommonAPI.hpp>
+
+namespace {
+
+// Queues the tasks until they are run by the test
+class QueueExecutor : public CommonAPI::Executor {
+public:
+    void execute(std::size_t _key, Task _task) {
+        (void)_key;
+        tasks_.push_back(std::move(_task));
+    }
+
+    std::size_t runAll() {
+        std::size_t itsCount(0);
+        while (!tasks_.empty()) {
+            Task itsTask = std::move(tasks_.front());
+            tasks_.pop_front();
+            itsTask();
+            itsCount++;
+        }
+        return itsCount;
+    }
+
+    std::deque<Task> tasks_;
+};
+
+} // namespace
+
+class TestEvent : public CommonAPI::Event<int> {
+public:
+    using CommonAPI::Event<int>::notifyListeners;
+    using CommonAPI::Event<int>::notifyListenersBatch;
+    using CommonAPI::Event<int>::notifySpecificListener;
+    using CommonAPI::Event<int>::notifySpecificError;
+    using CommonAPI::Event<int>::notifyErrorListeners;
+    using CommonAPI::Event<int>::getSubscriptionCount;
+};
+
+class EventTest : public ::testing::Test {
+protected:
+    TestEvent event_;
+};
+
+TEST_F(EventTest, SubscribeDuringNotificationTakesEffectWithNextNotification) {
+    int added(0), outer(0);
+    event_.subscribe([&](const int &) {
+        if (outer++ == 0)
+            event_.subscribe([&](const int &) { added++; });
+    });
+
+    event_.notifyListeners(1);
+    EXPECT_EQ(0, added);
+    EXPECT_EQ(2u, event_.getSubscriptionCount());
+
+    event_.notifyListeners(2);
+    EXPECT_EQ(1, added);
+    EXPECT_EQ(2, outer);
+}
+
+TEST_F(EventTest, UnsubscribeDuringNotificationSkipsRemovedListener) {
+    int first(0), second(0);
+    TestEvent::Subscription itsSecond(0);
+    event_.subscribe([&](const int &) {
+        first++;
+        event_.unsubscribe(itsSecond);
+    });
+    itsSecond = event_.subscribe([&](const int &) { second++; });
+
+    event_.notifyListeners(1);
+    event_.notifyListeners(2);
+    EXPECT_EQ(2, first);
+    EXPECT_EQ(0, second);
+    EXPECT_EQ(1u, event_.getSubscriptionCount());
+}
+
+TEST_F(EventTest, UnsubscribeItselfDuringNotification) {
+    int calls(0);
+    TestEvent::Subscription itsSubscription(0);
+    itsSubscription = event_.subscribe([&](const int &) {
+        calls++;
+        event_.unsubscribe(itsSubscription);
+    });
+
+    event_.notifyListeners(1);
+    event_.notifyListeners(2);
+    EXPECT_EQ(1, calls);
+    EXPECT_EQ(0u, event_.getSubscriptionCount());
+}
+
+TEST_F(EventTest, ConcurrentSubscriptionsDoNotDisturbNotifications) {
+    std::vector<int> received;
+    event_.subscribe([&](const int &_value) { received.push_back(_value); });
+
+    std::atomic<bool> isRunning(true);
+    std::thread itsChurn([&]() {
+        while (isRunning) {
+            auto itsSubscription = event_.subscribe([](const int &) {});
+            event_.unsubscribe(itsSubscription);
+        }
+    });
+
+    const int itsCount(20000);
+    for (int i = 0; i < itsCount; i++)
+        event_.notifyListeners(i);
+    isRunning = false;
+    itsChurn.join();
+
+    ASSERT_EQ(static_cast<std::size_t>(itsCount), received.size());
+    for (int i = 0; i < itsCount; i++)
+        ASSERT_EQ(i, received[static_cast<std::size_t>(i)]);
+    EXPECT_EQ(1u, event_.getSubscriptionCount());
+}
+
+TEST_F(EventTest, StaleSubscriptionsDoNotMatchReusedSlots) {
+    auto itsFirst = event_.subscribe([](const int &) {});
+    event_.unsubscribe(itsFirst);
+
+    // Cycles a slot through all of its generations, until it wraps
+    std::set<TestEvent::Subscription> itsSubscriptions { itsFirst };
+    for (int i = 0; i < 5000; i++) {
+        auto itsSubscription = event_.subscribe([](const int &) {});
+        EXPECT_TRUE(itsSubscriptions.insert(itsSubscription).second);
+        event_.unsubscribe(itsSubscription);
+    }
+
+    int calls(0);
+    auto itsLive = event_.subscribe([&](const int &) { calls++; });
+    EXPECT_EQ(0u, itsSubscriptions.count(itsLive));
+    for (auto s : itsSubscriptions)
+        event_.unsubscribe(s);
+    EXPECT_EQ(1u, event_.getSubscriptionCount());
+
+    event_.notifyListeners(1);
+    event_.notifySpecificListener(itsFirst, 2);
+    event_.notifySpecificListener(itsLive, 3);
+    EXPECT_EQ(2, calls);
+}
+
+TEST_F(EventTest, SpecificErrorIsDeliveredByExecutorAfterPendingValues) {
+    auto itsExecutor = std::make_shared<CommonAPI::ThreadPoolExecutor>(2);
+    event_.setExecutor(itsExecutor);
+
+    std::mutex itsMutex;
+    std::vector<int> received;
+    std::vector<CommonAPI::CallStatus> errors;
+    auto itsSubscription = event_.subscribe(
+        [&](const int &_value) {
+            std::lock_guard<std::mutex> itsLock(itsMutex);
+            received.push_back(_value);
+        },
+        [&](const CommonAPI::CallStatus _status) {
+            std::lock_guard<std::mutex> itsLock(itsMutex);
+            errors.push_back(_status);
+            received.push_back(-1);
+        });
+
+    event_.notifyListeners(1);
+    event_.notifyListeners(2);
+    event_.notifySpecificError(itsSubscription, CommonAPI::CallStatus::REMOTE_ERROR);
+    EXPECT_EQ(0u, event_.getSubscriptionCount());
+    event_.notifyListeners(3);
+
+    // Executes the pending tasks
+    event_.setExecutor(nullptr);
+    itsExecutor.reset();
+
+    ASSERT_EQ(1u, errors.size());
+    EXPECT_EQ(CommonAPI::CallStatus::REMOTE_ERROR, errors[0]);
+    EXPECT_EQ((std::vector<int>{ 1, 2, -1 }), received);
+}
+
+TEST_F(EventTest, NotificationsFromDifferentThreadsDoNotWaitForEachOther) {
+    // Each listener call waits until both have started
+    std::atomic<int> entered(0);
+    event_.subscribe([&](const int &) {
+        entered++;
+        auto itsDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (entered < 2 && std::chrono::steady_clock::now() < itsDeadline)
+            std::this_thread::yield();
+    });
+
+    std::thread itsOther([&]() { event_.notifyListeners(1); });
+    event_.notifyListeners(2);
+    itsOther.join();
+    EXPECT_EQ(2, entered);
+}
+
+TEST_F(EventTest, SerializedNotificationsDoNotOverlap) {
+    event_.setSerializedNotifications(true);
+
+    std::atomic<int> inside(0), nested(0);
+    std::atomic<bool> hasOverlapped(false);
+    event_.subscribe([&](const int &_value) {
+        if (++inside > 1)
+            hasOverlapped = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        inside--;
+        // Notifying the event from its own listener does not wait
+        if (_value > 0)
+            event_.notifyListeners(-_value);
+        else
+            nested++;
+    });
+
+    std::thread itsOther([&]() {
+        for (int i = 1; i <= 5; i++)
+            event_.notifyListeners(i);
+    });
+    for (int i = 1; i <= 5; i++)
+        event_.notifyListeners(i);
+    itsOther.join();
+
+    EXPECT_FALSE(hasOverlapped);
+    EXPECT_EQ(10, nested);
+}
+
+TEST_F(EventTest, BatchListenerIsCalledOncePerBatch) {
+    std::vector<std::vector<int>> batches;
+    event_.subscribeBatch([&](const TestEvent::ArgumentsTuple *_samples, std::size_t _count) {
+        std::vector<int> itsBatch;
+        for (std::size_t i = 0; i < _count; i++)
+            itsBatch.push_back(std::get<0>(_samples[i]));
+        batches.push_back(itsBatch);
+    });
+
+    const TestEvent::ArgumentsTuple itsSamples[] = { 1, 2, 3 };
+    event_.notifyListenersBatch(itsSamples, 3);
+    event_.notifyListeners(4);
+
+    ASSERT_EQ(2u, batches.size());
+    EXPECT_EQ((std::vector<int>{ 1, 2, 3 }), batches[0]);
+    EXPECT_EQ((std::vector<int>{ 4 }), batches[1]);
+}
+
+TEST_F(EventTest, BatchIsUnrolledForSingleSampleListeners) {
+    std::vector<int> received;
+    event_.subscribe([&](const int &_value) { received.push_back(_value); });
+
+    const TestEvent::ArgumentsTuple itsSamples[] = { 1, 2, 3 };
+    event_.notifyListenersBatch(itsSamples, 3);
+    EXPECT_EQ((std::vector<int>{ 1, 2, 3 }), received);
+}
+
+TEST_F(EventTest, CancelInsideBatchStopsOnlyThatListener) {
+    std::vector<int> cancelled, other;
+    event_.subscribeCancellable([&](const int &_value) {
+        cancelled.push_back(_value);
+        return (_value == 2 ? CommonAPI::SubscriptionStatus::CANCEL
+                            : CommonAPI::SubscriptionStatus::RETAIN);
+    });
+    event_.subscribe([&](const int &_value) { other.push_back(_value); });
+
+    const TestEvent::ArgumentsTuple itsSamples[] = { 1, 2, 3 };
+    event_.notifyListenersBatch(itsSamples, 3);
+    EXPECT_EQ(1u, event_.getSubscriptionCount());
+    event_.notifyListenersBatch(itsSamples, 3);
+
+    EXPECT_EQ((std::vector<int>{ 1, 2 }), cancelled);
+    EXPECT_EQ((std::vector<int>{ 1, 2, 3, 1, 2, 3 }), other);
+}
+
+TEST_F(EventTest, ExecutorReceivesACopyOfTheBatch) {
+    auto itsExecutor = std::make_shared<QueueExecutor>();
+    event_.setExecutor(itsExecutor);
+
+    std::vector<int> batch, single;
+    event_.subscribeBatch([&](const TestEvent::ArgumentsTuple *_samples, std::size_t _count) {
+        for (std::size_t i = 0; i < _count; i++)
+            batch.push_back(std::get<0>(_samples[i]));
+    });
+    event_.subscribe([&](const int &_value) { single.push_back(_value); });
+
+    {
+        std::vector<TestEvent::ArgumentsTuple> itsSamples { 1, 2, 3 };
+        event_.notifyListenersBatch(itsSamples.data(), itsSamples.size());
+        itsSamples.assign(3, TestEvent::ArgumentsTuple(0));
+    }
+    EXPECT_TRUE(batch.empty());
+
+    EXPECT_EQ(2u, itsExecutor->runAll());
+    EXPECT_EQ((std::vector<int>{ 1, 2, 3 }), batch);
+    EXPECT_EQ((std::vector<int>{ 1, 2, 3 }), single);
+}
+
+TEST_F(EventTest, EmptyBatchCallsNoListener) {
+    int calls(0);
+    event_.subscribe([&](const int &) { calls++; });
+    event_.subscribeBatch([&](const TestEvent::ArgumentsTuple *, std::size_t) { calls++; });
+
+    event_.notifyListenersBatch(nullptr, 0);
+    EXPECT_EQ(0, calls);
+
+    auto itsExecutor = std::make_shared<QueueExecutor>();
+    event_.setExecutor(itsExecutor);
+    event_.notifyListenersBatch(nullptr, 0);
+    EXPECT_EQ(0u, itsExecutor->runAll());
+    EXPECT_EQ(0, calls);
+}
+
+TEST_F(EventTest, ConflatingListenerOnlyReceivesNewestQueuedValue) {
+    auto itsExecutor = std::make_shared<QueueExecutor>();
+    event_.setExecutor(itsExecutor);
+
+    std::vector<int> latest, all;
+    event_.subscribeConflating([&](const int &_value) { latest.push_back(_value); });
+    event_.subscribe([&](const int &_value) { all.push_back(_value); });
+
+    for (int i = 1; i <= 5; i++)
+        event_.notifyListeners(i);
+    itsExecutor->runAll();
+    event_.notifyListeners(6);
+    itsExecutor->runAll();
+
+    EXPECT_EQ((std::vector<int>{ 5, 6 }), latest);
+    EXPECT_EQ((std::vector<int>{ 1, 2, 3, 4, 5, 6 }), all);
+}
+
+TEST_F(EventTest, ConflatingListenerReceivesNewestValueAfterBlockingCall) {
+    auto itsExecutor = std::make_shared<CommonAPI::ThreadPoolExecutor>(1);
+    event_.setExecutor(itsExecutor);
+
+    std::mutex itsMutex;
+    std::condition_variable itsCondition;
+    bool isBlocking(false), isReleased(false);
+    std::vector<int> received;
+    event_.subscribeConflating([&](const int &_value) {
+        std::unique_lock<std::mutex> itsLock(itsMutex);
+        received.push_back(_value);
+        if (_value == 1) {
+            isBlocking = true;
+            itsCondition.notify_all();
+            itsCondition.wait(itsLock, [&]() { return isReleased; });
+        }
+    });
+
+    event_.notifyListeners(1);
+    {
+        std::unique_lock<std::mutex> itsLock(itsMutex);
+        itsCondition.wait(itsLock, [&]() { return isBlocking; });
+    }
+
+    // Overwrite each other while the listener is busy
+    for (int i = 2; i <= 100; i++)
+        event_.notifyListeners(i);
+    {
+        std::lock_guard<std::mutex> itsLock(itsMutex);
+        isReleased = true;
+    }
+    itsCondition.notify_all();
+
+    event_.setExecutor(nullptr);
+    itsExecutor.reset();
+    EXPECT_EQ((std::vector<int>{ 1, 100 }), received);
+}
+
+TEST_F(EventTest, ConflatingListenerIsNotCalledRecursively) {
+    std::vector<int> received;
+    event_.subscribeConflating([&](const int &_value) {
+        received.push_back(_value);
+        if (_value == 1) {
+            event_.notifyListeners(2);
+            event_.notifyListeners(3);
+            EXPECT_EQ(1u, received.size());
+        }
+    });
+
+    event_.notifyListeners(1);
+    EXPECT_EQ((std::vector<int>{ 1, 3 }), received);
+}
+
+TEST_F(EventTest, ConflatingListenerDropsPendingValueWhenUnsubscribed) {
+    auto itsExecutor = std::make_shared<QueueExecutor>();
+    event_.setExecutor(itsExecutor);
+
+    std::vector<int> received;
+    TestEvent::Subscription itsSubscription(0);
+    itsSubscription = event_.subscribeConflating([&](const int &_value) {
+        received.push_back(_value);
+        // Newer value is pending while unsubscribing
+        event_.notifyListeners(_value + 1);
+        event_.unsubscribe(itsSubscription);
+    });
+
+    event_.notifyListeners(1);
+    itsExecutor->runAll();
+    event_.notifyListeners(10);
+    itsExecutor->runAll();
+    EXPECT_EQ((std::vector<int>{ 1 }), received);
+}
+
+TEST_F(EventTest, ConflatingListenerReceivesNewestSampleOfBatch) {
+    std::vector<int> received;
+    event_.subscribeConflating([&](const int &_value) { received.push_back(_value); });
+
+    const TestEvent::ArgumentsTuple itsSamples[] = { 1, 2, 3 };
+    event_.notifyListenersBatch(itsSamples, 3);
+    EXPECT_EQ((std::vector<int>{ 3 }), received);
+
+    auto itsExecutor = std::make_shared<QueueExecutor>();
+    event_.setExecutor(itsExecutor);
+    {
+        std::vector<TestEvent::ArgumentsTuple> itsBatch { 4, 5, 6 };
+        event_.notifyListenersBatch(itsBatch.data(), itsBatch.size());
+        itsBatch.assign(3, TestEvent::ArgumentsTuple(0));
+    }
+    event_.notifyListenersBatch(itsSamples, 2);
+    itsExecutor->runAll();
+    EXPECT_EQ((std::vector<int>{ 3, 2 }), received);
+}
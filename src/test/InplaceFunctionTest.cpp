@@ -0,0 +1,113 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+#include <CommonAPI/CommonAPI.hpp>
+
+namespace {
+
+std::atomic<std::size_t> allocations(0);
+
+} // namespace
+
+// Counts the allocations of the test
+void *operator new(std::size_t _size) {
+    allocations++;
+    if (void *itsMemory = std::malloc(_size ? _size : 1))
+        return itsMemory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *_memory) noexcept {
+    std::free(_memory);
+}
+
+void operator delete(void *_memory, std::size_t) noexcept {
+    std::free(_memory);
+}
+
+namespace {
+
+class TestEvent : public CommonAPI::Event<int> {
+public:
+    using CommonAPI::Event<int>::notifyListeners;
+};
+
+typedef CommonAPI::InplaceFunction<int(int)> Function;
+
+} // namespace
+
+static_assert(!std::is_copy_constructible<Function>::value, "InplaceFunction must be move-only");
+static_assert(!std::is_copy_assignable<Function>::value, "InplaceFunction must be move-only");
+static_assert(std::is_nothrow_move_constructible<Function>::value, "InplaceFunction must be movable");
+
+TEST(InplaceFunctionTest, StoresSmallCallablesInline) {
+    // Larger than the inline buffer of std::function
+    int64_t a(1), b(2), c(3), d(4), e(5);
+
+    std::size_t itsAllocations(allocations);
+    Function itsFunction([a, b, c, d, e](int _value) {
+        return static_cast<int>(a + b + c + d + e) + _value;
+    });
+    Function itsMoved(std::move(itsFunction));
+    EXPECT_EQ(20, itsMoved(5));
+    EXPECT_EQ(itsAllocations, allocations);
+
+    EXPECT_FALSE(itsFunction);
+    EXPECT_THROW(itsFunction(1), std::bad_function_call);
+}
+
+TEST(InplaceFunctionTest, StoresMoveOnlyAndLargeCallables) {
+    std::unique_ptr<int> itsValue(new int(7));
+    Function itsMoveOnly([itsValue = std::move(itsValue)](int _value) { return *itsValue * _value; });
+    EXPECT_EQ(14, itsMoveOnly(2));
+
+    struct Large {
+        char data_[256];
+    } itsLarge { { 3 } };
+    std::size_t itsAllocations(allocations);
+    Function itsAllocated([itsLarge](int _value) { return itsLarge.data_[0] + _value; });
+    EXPECT_EQ(itsAllocations + 1, allocations);
+
+    Function itsMoved;
+    itsMoved = std::move(itsAllocated);
+    EXPECT_EQ(4, itsMoved(1));
+    EXPECT_EQ(itsAllocations + 1, allocations);
+}
+
+TEST(InplaceFunctionTest, NullCallablesResultInEmptyFunctions) {
+    int (*itsPointer)(int) = nullptr;
+    EXPECT_FALSE(Function(itsPointer));
+    EXPECT_FALSE(Function(std::function<int(int)>()));
+    EXPECT_FALSE(Function(nullptr));
+    EXPECT_TRUE(Function(std::function<int(int)>([](int _value) { return _value; })));
+}
+
+TEST(InplaceFunctionTest, EventStoresTheCallableOfSubscribe) {
+    TestEvent itsEvent;
+
+    // A std::function could not store it at all
+    std::unique_ptr<int> itsSum(new int(0));
+    int *itsResult = itsSum.get();
+    int64_t a(1), b(2), c(3);
+    itsEvent.subscribe([itsSum = std::move(itsSum), a, b, c](const int &_value) {
+        *itsSum += _value + static_cast<int>(a + b + c);
+    });
+    itsEvent.notifyListeners(0);
+
+    std::size_t itsAllocations(allocations);
+    for (int i = 1; i <= 100; i++)
+        itsEvent.notifyListeners(i);
+    EXPECT_EQ(itsAllocations, allocations);
+    EXPECT_EQ(6 + 5050 + 100 * 6, *itsResult);
+}
@@ -0,0 +1,91 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CommonAPI/CommonAPI.hpp>
+#include <CommonAPI/InternedAddress.hpp>
+
+TEST(InternedAddressTest, EqualAddressesShareTheirEntry) {
+    CommonAPI::InternedAddress itsFromParts("local", "test.Interface:v1_0", "instance");
+    CommonAPI::InternedAddress itsFromString(std::string("local:test.Interface:v1_0:instance"));
+    CommonAPI::InternedAddress itsFromAddress(CommonAPI::Address("local", "test.Interface:v1_0", "instance"));
+
+    EXPECT_EQ(itsFromParts, itsFromString);
+    EXPECT_EQ(itsFromParts, itsFromAddress);
+    EXPECT_EQ(&itsFromParts.getAddress(), &itsFromString.getAddress());
+    EXPECT_EQ(itsFromParts.getHash(), itsFromAddress.getHash());
+    EXPECT_EQ(std::hash<CommonAPI::InternedAddress>()(itsFromParts), itsFromParts.getHash());
+}
+
+TEST(InternedAddressTest, DifferentAddressesDiffer) {
+    CommonAPI::InternedAddress itsAddress("local", "test.Interface:v1_0", "a");
+    CommonAPI::InternedAddress itsOtherInstance("local", "test.Interface:v1_0", "b");
+    CommonAPI::InternedAddress itsOtherDomain("remote", "test.Interface:v1_0", "a");
+
+    EXPECT_NE(itsAddress, itsOtherInstance);
+    EXPECT_NE(itsAddress, itsOtherDomain);
+    EXPECT_EQ(itsAddress.getInterfaceId(), itsOtherInstance.getInterfaceId());
+    EXPECT_NE(itsAddress.getInstanceId(), itsOtherInstance.getInstanceId());
+
+    // Strict weak order, consistent with equality
+    EXPECT_TRUE((itsAddress < itsOtherInstance) != (itsOtherInstance < itsAddress));
+    EXPECT_FALSE(itsAddress < itsAddress);
+}
+
+TEST(InternedAddressTest, ConvertsToAddressAndString) {
+    CommonAPI::InternedAddress itsAddress("local", "test.Interface:v1_0", "instance");
+    const CommonAPI::Address &itsPlain = itsAddress;
+
+    EXPECT_EQ("local", itsPlain.getDomain());
+    EXPECT_EQ("test.Interface:v1_0", itsAddress.getInterface());
+    EXPECT_EQ("instance", itsAddress.getInstance());
+    EXPECT_EQ("local:test.Interface:v1_0:instance", itsAddress.getAddress());
+
+    std::stringstream itsStream;
+    itsStream << itsAddress;
+    EXPECT_EQ(itsAddress.getAddress(), itsStream.str());
+
+    EXPECT_EQ(CommonAPI::InternedAddress(CommonAPI::Address()), CommonAPI::InternedAddress());
+}
+
+TEST(InternedAddressTest, UsableAsKeyOfOrderedAndUnorderedContainers) {
+    std::unordered_map<CommonAPI::InternedAddress, int> itsUnordered;
+    std::set<CommonAPI::InternedAddress> itsOrdered;
+    for (int i = 0; i < 100; i++) {
+        CommonAPI::InternedAddress itsAddress("local", "test.Interface:v1_0", std::to_string(i % 10));
+        itsUnordered[itsAddress]++;
+        itsOrdered.insert(itsAddress);
+    }
+
+    EXPECT_EQ(10u, itsUnordered.size());
+    EXPECT_EQ(10u, itsOrdered.size());
+    EXPECT_EQ(10, itsUnordered[CommonAPI::InternedAddress("local", "test.Interface:v1_0", "3")]);
+}
+
+TEST(InternedAddressTest, ConcurrentInterningYieldsOneEntry) {
+    const std::size_t itsThreads(4), itsAddresses(500);
+    std::vector<std::vector<CommonAPI::InternedAddress>> itsResults(itsThreads);
+    std::vector<std::thread> itsWorkers;
+    for (std::size_t t = 0; t < itsThreads; t++) {
+        itsWorkers.emplace_back([&itsResults, t, itsAddresses]() {
+            for (std::size_t i = 0; i < itsAddresses; i++)
+                itsResults[t].emplace_back("concurrent", "test.Interface:v1_0", std::to_string(i));
+        });
+    }
+    for (auto &w : itsWorkers)
+        w.join();
+
+    for (std::size_t t = 1; t < itsThreads; t++)
+        for (std::size_t i = 0; i < itsAddresses; i++)
+            ASSERT_EQ(itsResults[0][i], itsResults[t][i]);
+}
@@ -0,0 +1,210 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CommonAPI/AtomicSnapshot.hpp>
+#include <CommonAPI/CommonAPI.hpp>
+
+namespace {
+
+struct Value {
+    Value(int _value) : first_(_value), second_(_value) { instances__++; }
+    ~Value() { instances__--; }
+
+    int first_;
+    int second_;
+
+    static std::atomic<int> instances__;
+};
+
+std::atomic<int> Value::instances__(0);
+
+class TestSource : public CommonAPI::DispatchSource {
+public:
+    bool prepare(int64_t &) { return false; }
+    bool check() { return false; }
+    bool dispatch() { return false; }
+};
+
+} // namespace
+
+TEST(AtomicSnapshotTest, ReferencesOutliveReplacedValues) {
+    {
+        CommonAPI::AtomicSnapshot<Value> itsSnapshot;
+        EXPECT_FALSE(itsSnapshot.load());
+
+        itsSnapshot.emplace(1);
+        auto itsFirst = itsSnapshot.load();
+        itsSnapshot.emplace(2);
+        EXPECT_EQ(1, itsFirst->first_);
+        EXPECT_EQ(2, itsSnapshot.load()->first_);
+        EXPECT_EQ(2, Value::instances__);
+
+        itsFirst = CommonAPI::AtomicSnapshot<Value>::Reference();
+        EXPECT_EQ(1, Value::instances__);
+
+        itsSnapshot.reset();
+        EXPECT_FALSE(itsSnapshot.load());
+        EXPECT_EQ(0, Value::instances__);
+        itsSnapshot.emplace(3);
+    }
+    EXPECT_EQ(0, Value::instances__);
+}
+
+TEST(AtomicSnapshotTest, ReadersSeeCompleteValuesWhileReplaced) {
+    CommonAPI::AtomicSnapshot<Value> itsSnapshot;
+    itsSnapshot.emplace(1);
+
+    std::atomic<bool> isRunning(true);
+    std::atomic<int> itsInconsistent(0);
+    std::vector<std::thread> itsReaders;
+    for (int i = 0; i < 3; i++) {
+        itsReaders.emplace_back([&]() {
+            while (isRunning) {
+                auto itsValue = itsSnapshot.load();
+                if (!itsValue || itsValue->first_ != itsValue->second_ || itsValue->first_ <= 0)
+                    itsInconsistent++;
+            }
+        });
+    }
+    for (int i = 2; i < 5000; i++)
+        itsSnapshot.emplace(i);
+    isRunning = false;
+    for (auto &r : itsReaders)
+        r.join();
+
+    EXPECT_EQ(0, itsInconsistent);
+}
+
+TEST(MainLoopContextTest, NotifiesListenersOfRegistrations) {
+    auto itsContext = std::make_shared<CommonAPI::MainLoopContext>("MainLoopContextTest");
+    EXPECT_FALSE(itsContext->isInitialized());
+
+    TestSource itsSource;
+    int itsAdded(0), itsRemoved(0);
+    auto itsSubscription = itsContext->subscribeForDispatchSources(
+        [&](CommonAPI::DispatchSource *_source, const CommonAPI::DispatchPriority _priority) {
+            EXPECT_EQ(&itsSource, _source);
+            EXPECT_EQ(CommonAPI::DispatchPriority::HIGH, _priority);
+            itsAdded++;
+        },
+        [&](CommonAPI::DispatchSource *_source) {
+            EXPECT_EQ(&itsSource, _source);
+            itsRemoved++;
+        });
+    EXPECT_TRUE(itsContext->isInitialized());
+
+    itsContext->registerDispatchSource(&itsSource, CommonAPI::DispatchPriority::HIGH);
+    itsContext->deregisterDispatchSource(&itsSource);
+    itsContext->unsubscribeForDispatchSources(itsSubscription);
+    itsContext->registerDispatchSource(&itsSource, CommonAPI::DispatchPriority::HIGH);
+
+    EXPECT_EQ(1, itsAdded);
+    EXPECT_EQ(1, itsRemoved);
+}
+
+TEST(MainLoopContextTest, ListenerMayUnsubscribeItself) {
+    auto itsContext = std::make_shared<CommonAPI::MainLoopContext>("MainLoopContextTest");
+
+    int itsCalls(0);
+    CommonAPI::WakeupListenerSubscription itsSubscription;
+    itsSubscription = itsContext->subscribeForWakeupEvents([&]() {
+        itsCalls++;
+        itsContext->unsubscribeForWakeupEvents(itsSubscription);
+    });
+
+    itsContext->wakeup();
+    itsContext->wakeup();
+    EXPECT_EQ(1, itsCalls);
+}
+
+TEST(MainLoopContextTest, UnsubscribeWaitsForConcurrentCall) {
+    auto itsContext = std::make_shared<CommonAPI::MainLoopContext>("MainLoopContextTest");
+
+    std::atomic<bool> isCalled(false), isReleased(false), isReturned(false);
+    auto itsSubscription = itsContext->subscribeForWakeupEvents([&]() {
+        isCalled = true;
+        while (!isReleased)
+            std::this_thread::yield();
+        isReturned = true;
+    });
+
+    std::thread itsNotifier([&]() { itsContext->wakeup(); });
+    while (!isCalled)
+        std::this_thread::yield();
+    std::thread itsReleaser([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        isReleased = true;
+    });
+
+    itsContext->unsubscribeForWakeupEvents(itsSubscription);
+    EXPECT_TRUE(isReturned);
+
+    itsNotifier.join();
+    itsReleaser.join();
+}
+
+TEST(MainLoopContextTest, WakeupsAreCoalescedUntilAcknowledged) {
+    auto itsContext = std::make_shared<CommonAPI::MainLoopContext>("MainLoopContextTest");
+    int itsWakeups(0);
+    auto itsSubscription = itsContext->subscribeForWakeupEvents([&]() { itsWakeups++; });
+
+    itsContext->wakeup();
+    itsContext->wakeup();
+    EXPECT_EQ(2, itsWakeups);
+    EXPECT_EQ(0u, itsContext->getSuppressedWakeups());
+
+    itsContext->setWakeupCoalescing(true);
+    for (int i = 0; i < 3; i++)
+        itsContext->wakeup();
+    EXPECT_EQ(3, itsWakeups);
+    EXPECT_EQ(2u, itsContext->getSuppressedWakeups());
+
+    itsContext->acknowledgeWakeup();
+    itsContext->wakeup();
+    itsContext->wakeup();
+    EXPECT_EQ(4, itsWakeups);
+    EXPECT_EQ(3u, itsContext->getSuppressedWakeups());
+
+    itsContext->setWakeupCoalescing(false);
+    itsContext->wakeup();
+    EXPECT_EQ(5, itsWakeups);
+    EXPECT_EQ(3u, itsContext->getSuppressedWakeups());
+
+    itsContext->unsubscribeForWakeupEvents(itsSubscription);
+}
+
+TEST(MainLoopContextTest, WakeupCoalescingIsCounted) {
+    auto itsContext = std::make_shared<CommonAPI::MainLoopContext>("MainLoopContextTest");
+    int itsWakeups(0);
+    auto itsSubscription = itsContext->subscribeForWakeupEvents([&]() { itsWakeups++; });
+
+    itsContext->setWakeupCoalescing(true);
+    itsContext->setWakeupCoalescing(true);
+    itsContext->setWakeupCoalescing(false);
+    itsContext->wakeup();
+    itsContext->wakeup();
+    EXPECT_EQ(1, itsWakeups);
+
+    // Unbalanced disabling does not prevent enabling it again
+    itsContext->setWakeupCoalescing(false);
+    itsContext->setWakeupCoalescing(false);
+    itsContext->wakeup();
+    EXPECT_EQ(2, itsWakeups);
+    itsContext->setWakeupCoalescing(true);
+    itsContext->wakeup();
+    itsContext->wakeup();
+    EXPECT_EQ(3, itsWakeups);
+    EXPECT_EQ(2u, itsContext->getSuppressedWakeups());
+
+    itsContext->unsubscribeForWakeupEvents(itsSubscription);
+}
@@ -0,0 +1,454 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CommonAPI/CommonAPI.hpp>
+#include <CommonAPI/MainLoop.hpp>
+#include <CommonAPI/SimulatedMainLoop.hpp>
+
+namespace {
+
+// Ready until dispatched once
+class OnceSource : public CommonAPI::DispatchSource {
+public:
+    OnceSource() : isReady_(true) {}
+
+    bool prepare(int64_t &_timeout) {
+        _timeout = CommonAPI::TIMEOUT_INFINITE;
+        return isReady_;
+    }
+
+    bool check() {
+        return isReady_;
+    }
+
+    bool dispatch() {
+        isReady_ = false;
+        if (action_)
+            action_();
+        return false;
+    }
+
+    std::atomic<bool> isReady_;
+    std::function<void()> action_;
+};
+
+// Always has more units to dispatch, each unit is of the given size
+class BusySource : public CommonAPI::BudgetedDispatchSource {
+public:
+    BusySource(std::size_t _quantum, std::size_t _unit = 1)
+        : quantum_(_quantum), unit_(_unit), consumed_(0), calls_(0), maximum_(0) {}
+
+    bool prepare(int64_t &_timeout) {
+        _timeout = CommonAPI::TIMEOUT_INFINITE;
+        return true;
+    }
+
+    bool check() {
+        return true;
+    }
+
+    bool dispatchWithBudget(std::size_t _budget, std::size_t &_consumed) {
+        _consumed = (_budget / unit_) * unit_;
+        consumed_ += _consumed;
+        maximum_ = std::max(maximum_, _consumed);
+        calls_++;
+        return true;
+    }
+
+    std::size_t getDispatchQuantum() const {
+        return quantum_;
+    }
+
+    std::size_t quantum_;
+    std::size_t unit_;
+    std::size_t consumed_;
+    std::size_t calls_;
+    std::size_t maximum_;
+};
+
+// Reads the data of a pipe
+class PipeWatch : public CommonAPI::Watch {
+public:
+    PipeWatch(int _fd) : dispatches_(0), events_(0) {
+        fd_.fd = _fd;
+        fd_.events = POLLIN;
+        fd_.revents = 0;
+    }
+
+    void dispatch(unsigned int _events) {
+        events_ = _events;
+        dispatches_++;
+        char itsData[64];
+        while (read(fd_.fd, itsData, sizeof(itsData)) > 0) {
+        }
+        if (action_)
+            action_();
+    }
+
+    const pollfd &getAssociatedFileDescriptor() {
+        return fd_;
+    }
+
+    const std::vector<CommonAPI::DispatchSource *> &getDependentDispatchSources() {
+        return sources_;
+    }
+
+    pollfd fd_;
+    std::vector<CommonAPI::DispatchSource *> sources_;
+    int dispatches_;
+    unsigned int events_;
+    std::function<void()> action_;
+};
+
+// Due once at the given time
+class OnceTimeout : public CommonAPI::Timeout {
+public:
+    OnceTimeout(int64_t _readyTime) : readyTime_(_readyTime), dispatches_(0), dispatchTime_(0) {}
+
+    bool dispatch() {
+        dispatches_++;
+        dispatchTime_ = CommonAPI::getCurrentTimeInMs();
+        if (action_)
+            action_();
+        return false;
+    }
+
+    int64_t getTimeoutInterval() const {
+        return 1;
+    }
+
+    int64_t getReadyTime() const {
+        return readyTime_;
+    }
+
+    int64_t readyTime_;
+    int dispatches_;
+    int64_t dispatchTime_;
+    std::function<void()> action_;
+};
+
+// Non-blocking pipe, closed on destruction
+struct Pipe {
+    Pipe() {
+        if (pipe2(fds_, O_NONBLOCK | O_CLOEXEC) < 0)
+            fds_[0] = fds_[1] = -1;
+    }
+
+    ~Pipe() {
+        for (int fd : fds_) {
+            if (fd >= 0)
+                close(fd);
+        }
+    }
+
+    void write() {
+        char itsData(1);
+        EXPECT_EQ(1, ::write(fds_[1], &itsData, 1));
+    }
+
+    int fds_[2];
+};
+
+} // namespace
+
+class MainLoopTest : public ::testing::Test {
+protected:
+    void SetUp() {
+        context_ = std::make_shared<CommonAPI::MainLoopContext>("MainLoopTest");
+    }
+
+    std::shared_ptr<CommonAPI::MainLoopContext> context_;
+};
+
+TEST_F(MainLoopTest, IdleWorkersStealFromBlockedWorker) {
+    CommonAPI::MainLoop itsLoop(context_, 2);
+
+    std::mutex itsMutex;
+    std::condition_variable itsCondition;
+    bool isReleased(false);
+    std::atomic<int> itsDispatched(0);
+
+    // Sources are dispatched in the order of their addresses, thus the
+    // blocking one is handed to a worker first and the following ones
+    // are queued alternately to both workers.
+    OnceSource itsSources[9];
+    itsSources[0].action_ = [&]() {
+        std::unique_lock<std::mutex> itsLock(itsMutex);
+        itsCondition.wait(itsLock, [&]() { return isReleased; });
+    };
+    for (std::size_t i = 1; i < 9; i++)
+        itsSources[i].action_ = [&]() { itsDispatched++; };
+    for (auto &s : itsSources)
+        context_->registerDispatchSource(&s);
+
+    EXPECT_TRUE(itsLoop.iterate(0));
+
+    auto itsDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (itsDispatched < 8 && std::chrono::steady_clock::now() < itsDeadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    EXPECT_EQ(8, itsDispatched);
+
+    {
+        std::lock_guard<std::mutex> itsLock(itsMutex);
+        isReleased = true;
+    }
+    itsCondition.notify_all();
+
+    for (auto &s : itsSources)
+        context_->deregisterDispatchSource(&s);
+}
+
+TEST_F(MainLoopTest, BudgetedSourcesShareDispatchByQuantum) {
+    CommonAPI::MainLoop itsLoop(context_);
+    BusySource itsSmall(10), itsLarge(30);
+    OnceSource itsQuiet;
+    context_->registerDispatchSource(&itsSmall);
+    context_->registerDispatchSource(&itsLarge);
+    context_->registerDispatchSource(&itsQuiet);
+
+    int itsQuietCalls(0);
+    itsQuiet.action_ = [&]() { itsQuietCalls++; };
+    for (int i = 0; i < 100; i++) {
+        itsQuiet.isReady_ = true;
+        itsLoop.iterate(0);
+    }
+
+    // A busy source neither exceeds its quantum nor starves the others
+    EXPECT_EQ(100, itsQuietCalls);
+    EXPECT_EQ(100u, itsSmall.calls_);
+    EXPECT_EQ(10u, itsSmall.maximum_);
+    EXPECT_EQ(30u, itsLarge.maximum_);
+    EXPECT_EQ(3 * itsSmall.consumed_, itsLarge.consumed_);
+
+    context_->deregisterDispatchSource(&itsSmall);
+    context_->deregisterDispatchSource(&itsLarge);
+    context_->deregisterDispatchSource(&itsQuiet);
+}
+
+TEST_F(MainLoopTest, UnusedBudgetIsCarriedOver) {
+    CommonAPI::MainLoop itsLoop(context_);
+
+    // Units are larger than the quantum, thus need the deficit of a round
+    BusySource itsSource(10, 15);
+    context_->registerDispatchSource(&itsSource);
+    for (int i = 0; i < 30; i++)
+        itsLoop.iterate(0);
+
+    EXPECT_EQ(30u, itsSource.calls_);
+    EXPECT_LE(itsSource.consumed_, 300u);
+    EXPECT_GE(itsSource.consumed_, 300u - 15u);
+    EXPECT_LE(itsSource.maximum_, 15u);
+
+    context_->deregisterDispatchSource(&itsSource);
+}
+
+TEST_F(MainLoopTest, WatchIsDispatchedWhenItsDescriptorBecomesReadable) {
+    CommonAPI::MainLoop itsLoop(context_);
+    Pipe itsPipe;
+    ASSERT_GE(itsPipe.fds_[0], 0);
+    PipeWatch itsWatch(itsPipe.fds_[0]);
+    context_->registerWatch(&itsWatch);
+
+    EXPECT_FALSE(itsLoop.iterate(0));
+    EXPECT_EQ(0, itsWatch.dispatches_);
+
+    itsPipe.write();
+    EXPECT_TRUE(itsLoop.iterate(5000));
+    EXPECT_EQ(1, itsWatch.dispatches_);
+    EXPECT_TRUE(itsWatch.events_ & POLLIN);
+
+    // Drained, thus not ready anymore
+    EXPECT_FALSE(itsLoop.iterate(0));
+    EXPECT_EQ(1, itsWatch.dispatches_);
+
+    context_->deregisterWatch(&itsWatch);
+    itsPipe.write();
+    EXPECT_FALSE(itsLoop.iterate(0));
+    EXPECT_EQ(1, itsWatch.dispatches_);
+}
+
+TEST_F(MainLoopTest, TimeoutIsDispatchedAtItsReadyTime) {
+    CommonAPI::MainLoop itsLoop(context_);
+    const int64_t itsStart(CommonAPI::getCurrentTimeInMs());
+    OnceTimeout itsTimeout(itsStart + 50);
+    context_->registerTimeoutSource(&itsTimeout);
+
+    while (itsTimeout.dispatches_ == 0 && CommonAPI::getCurrentTimeInMs() < itsStart + 5000)
+        (void)itsLoop.iterate();
+
+    // Deregistered as its dispatch returned false
+    EXPECT_EQ(1, itsTimeout.dispatches_);
+    EXPECT_GE(itsTimeout.dispatchTime_, itsStart + 50);
+    EXPECT_LT(itsTimeout.dispatchTime_, itsStart + 1000);
+    EXPECT_FALSE(itsLoop.iterate(100));
+    EXPECT_EQ(1, itsTimeout.dispatches_);
+}
+
+TEST_F(MainLoopTest, WakeupInterruptsWaitingIteration) {
+    CommonAPI::MainLoop itsLoop(context_);
+
+    for (int i = 0; i < 2; i++) {
+        auto itsStart = std::chrono::steady_clock::now();
+        std::thread itsWaker([&]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            if (i == 0)
+                itsLoop.wakeup();
+            else
+                context_->wakeup();
+        });
+        EXPECT_FALSE(itsLoop.iterate(10000));
+        itsWaker.join();
+        EXPECT_LT(std::chrono::steady_clock::now() - itsStart, std::chrono::seconds(5));
+    }
+}
+
+TEST_F(MainLoopTest, DeregisteringDuringDispatchIsSafe) {
+    CommonAPI::MainLoop itsLoop(context_);
+
+    // Ready in the same iteration, each removes the other one
+    Pipe itsPipe;
+    ASSERT_GE(itsPipe.fds_[0], 0);
+    PipeWatch itsFirstWatch(itsPipe.fds_[0]), itsSecondWatch(itsPipe.fds_[0]);
+    itsFirstWatch.action_ = [&]() { context_->deregisterWatch(&itsSecondWatch); };
+    itsSecondWatch.action_ = [&]() { context_->deregisterWatch(&itsFirstWatch); };
+    context_->registerWatch(&itsFirstWatch);
+    context_->registerWatch(&itsSecondWatch);
+    itsPipe.write();
+
+    OnceTimeout itsFirstTimeout(0), itsSecondTimeout(0);
+    itsFirstTimeout.action_ = [&]() { context_->deregisterTimeoutSource(&itsSecondTimeout); };
+    itsSecondTimeout.action_ = [&]() { context_->deregisterTimeoutSource(&itsFirstTimeout); };
+    context_->registerTimeoutSource(&itsFirstTimeout);
+    context_->registerTimeoutSource(&itsSecondTimeout);
+
+    OnceSource itsFirstSource, itsSecondSource;
+    itsFirstSource.action_ = [&]() { context_->deregisterDispatchSource(&itsSecondSource); };
+    itsSecondSource.action_ = [&]() { context_->deregisterDispatchSource(&itsFirstSource); };
+    context_->registerDispatchSource(&itsFirstSource);
+    context_->registerDispatchSource(&itsSecondSource);
+
+    EXPECT_TRUE(itsLoop.iterate(5000));
+    EXPECT_EQ(1, itsFirstWatch.dispatches_ + itsSecondWatch.dispatches_);
+    EXPECT_EQ(1, itsFirstTimeout.dispatches_ + itsSecondTimeout.dispatches_);
+    EXPECT_EQ(1, int(!itsFirstSource.isReady_) + int(!itsSecondSource.isReady_));
+
+    // A watch may also remove itself
+    PipeWatch &itsRemaining = (itsFirstWatch.dispatches_ ? itsFirstWatch : itsSecondWatch);
+    itsRemaining.action_ = [&]() { context_->deregisterWatch(&itsRemaining); };
+    itsPipe.write();
+    EXPECT_TRUE(itsLoop.iterate(5000));
+    itsPipe.write();
+    EXPECT_FALSE(itsLoop.iterate(0));
+    EXPECT_EQ(2, itsRemaining.dispatches_);
+
+    context_->deregisterDispatchSource(&itsFirstSource);
+    context_->deregisterDispatchSource(&itsSecondSource);
+}
+
+TEST_F(MainLoopTest, TimeoutThatBecomesDueEarlierIsRescheduled) {
+    for (bool isPolling : { false, true }) {
+        CommonAPI::MainLoop itsLoop(context_);
+        itsLoop.setTimeoutPolling(isPolling);
+        int64_t itsStart = CommonAPI::getCurrentTimeInMs();
+        OnceTimeout itsTimeout(itsStart + 100000);
+        context_->registerTimeoutSource(&itsTimeout);
+        EXPECT_FALSE(itsLoop.iterate(0));
+
+        // Polled Timeouts need not register again
+        itsTimeout.readyTime_ = itsStart + 50;
+        if (!isPolling)
+            context_->registerTimeoutSource(&itsTimeout);
+
+        while (itsTimeout.dispatches_ == 0 && CommonAPI::getCurrentTimeInMs() < itsStart + 5000)
+            (void)itsLoop.iterate(10);
+        EXPECT_EQ(1, itsTimeout.dispatches_);
+        EXPECT_LT(itsTimeout.dispatchTime_, itsStart + 1000);
+    }
+}
+
+TEST_F(MainLoopTest, WakeupsAreCoalescedWhileALoopExists) {
+    int itsWakeups(0);
+    auto itsSubscription = context_->subscribeForWakeupEvents([&]() { itsWakeups++; });
+
+    std::unique_ptr<CommonAPI::MainLoop> itsFirstLoop(new CommonAPI::MainLoop(context_));
+    std::unique_ptr<CommonAPI::MainLoop> itsSecondLoop(new CommonAPI::MainLoop(context_));
+    uint64_t itsSuppressed = context_->getSuppressedWakeups();
+    context_->wakeup();
+    context_->wakeup();
+    EXPECT_EQ(1, itsWakeups);
+    EXPECT_EQ(itsSuppressed + 1, context_->getSuppressedWakeups());
+
+    // Destroying one loop does not disable coalescing for the other one
+    itsFirstLoop.reset();
+    (void)itsSecondLoop->iterate(0);
+    context_->wakeup();
+    context_->wakeup();
+    EXPECT_EQ(2, itsWakeups);
+    EXPECT_EQ(itsSuppressed + 2, context_->getSuppressedWakeups());
+
+    itsSecondLoop.reset();
+    context_->wakeup();
+    context_->wakeup();
+    EXPECT_EQ(4, itsWakeups);
+
+    context_->unsubscribeForWakeupEvents(itsSubscription);
+}
+
+TEST_F(MainLoopTest, SpinBudgetFollowsTheIntervalsBetweenReadyEvents) {
+    auto itsClock = std::make_shared<CommonAPI::SimulatedClock>(1000);
+    CommonAPI::setClock(itsClock);
+    {
+        CommonAPI::MainLoop itsLoop(context_);
+        const int64_t itsMaximum(1000000);
+        itsLoop.setSpinBudget(std::chrono::microseconds(itsMaximum / 1000));
+
+        auto signal = [&](std::chrono::nanoseconds _interval) {
+            itsClock->advance(_interval);
+            itsLoop.wakeup();
+            (void)itsLoop.iterate(0);
+            return itsLoop.getSpinStatistics().budget_;
+        };
+
+        // Under load, the budget grows towards twice the interval
+        int64_t itsBudget = signal(std::chrono::microseconds(10));
+        for (int i = 0; i < 32; i++) {
+            int64_t itsNext = signal(std::chrono::microseconds(10));
+            EXPECT_GE(itsNext, itsBudget);
+            itsBudget = itsNext;
+        }
+        EXPECT_GT(itsBudget, 10000);
+        EXPECT_LE(itsBudget, 20000);
+
+        // Idle, it shrinks to zero
+        for (int i = 0; i < 4; i++) {
+            int64_t itsNext = signal(std::chrono::milliseconds(10));
+            EXPECT_LE(itsNext, itsBudget);
+            itsBudget = itsNext;
+        }
+        EXPECT_EQ(0, itsBudget);
+
+        // And grows again under load
+        for (int i = 0; i < 64; i++)
+            itsBudget = signal(std::chrono::microseconds(10));
+        EXPECT_GT(itsBudget, 10000);
+        EXPECT_LE(itsBudget, itsMaximum);
+    }
+    CommonAPI::setClock(nullptr);
+}
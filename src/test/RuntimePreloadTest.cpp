@@ -0,0 +1,58 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <dirent.h>
+#include <dlfcn.h>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <CommonAPI/CommonAPI.hpp>
+
+namespace {
+
+bool isLibraryLoaded() {
+    auto itsLoaded = static_cast<const bool *>(dlsym(RTLD_DEFAULT, "runtimeTestLibraryLoaded"));
+    return (itsLoaded && *itsLoaded);
+}
+
+std::size_t getNumberOfThreads() {
+    std::size_t itsCount(0);
+    if (DIR *itsTasks = opendir("/proc/self/task")) {
+        while (dirent *itsEntry = readdir(itsTasks)) {
+            if (itsEntry->d_name[0] != '.')
+                itsCount++;
+        }
+        closedir(itsTasks);
+    }
+    return itsCount;
+}
+
+} // namespace
+
+// Run with configurations that contain "preload=true" or "preload=now"
+TEST(RuntimePreloadTest, PreloadLoadsTheMappedLibrary) {
+    std::size_t itsThreads = getNumberOfThreads();
+    EXPECT_FALSE(isLibraryLoaded());
+
+    auto itsRuntime = CommonAPI::Runtime::get();
+    ASSERT_TRUE(itsRuntime);
+    itsRuntime->waitForPreload();
+    EXPECT_TRUE(isLibraryLoaded());
+
+    // The threads of the preload are released once it finished
+    auto itsDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (getNumberOfThreads() > itsThreads && std::chrono::steady_clock::now() < itsDeadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    EXPECT_EQ(itsThreads, getNumberOfThreads());
+
+    // Preloading again does not load it twice
+    itsRuntime->preloadLibraries().wait();
+    EXPECT_TRUE(isLibraryLoaded());
+}
@@ -0,0 +1,290 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <dlfcn.h>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CommonAPI/CommonAPI.hpp>
+#include <CommonAPI/Proxy.hpp>
+
+namespace {
+
+class TestProxy : public CommonAPI::Proxy {
+public:
+    bool isAvailable() const {
+        return true;
+    }
+
+    bool isAvailableBlocking() const {
+        return true;
+    }
+
+    CommonAPI::ProxyStatusEvent &getProxyStatusEvent() {
+        return statusEvent_;
+    }
+
+    CommonAPI::InterfaceVersionAttribute &getInterfaceVersionAttribute() {
+        throw std::logic_error("not supported");
+    }
+
+private:
+    CommonAPI::ProxyStatusEvent statusEvent_;
+};
+
+template<typename ... AttributeExtensions_>
+class LibraryProxy {
+public:
+    static const char *getInterface() { return "test.Library:v1_0"; }
+    LibraryProxy(std::shared_ptr<CommonAPI::Proxy> _proxy) : proxy_(_proxy) {}
+
+    std::shared_ptr<CommonAPI::Proxy> proxy_;
+};
+
+template<typename ... AttributeExtensions_>
+class CacheProxy {
+public:
+    static const char *getInterface() { return "test.Cache:v1_0"; }
+    CacheProxy(std::shared_ptr<CommonAPI::Proxy> _proxy) : proxy_(_proxy) {}
+
+    std::shared_ptr<CommonAPI::Proxy> proxy_;
+};
+
+// Creates proxies for the instances it accepts, counts its calls
+class TestFactory : public CommonAPI::Factory {
+public:
+    TestFactory(std::function<bool (const std::string &)> _accept)
+        : calls_(0), accept_(_accept) {}
+
+    void init() {}
+
+    std::shared_ptr<CommonAPI::Proxy> createProxy(const std::string &, const std::string &,
+            const std::string &_instance, const CommonAPI::ConnectionId_t &) {
+        return create(_instance);
+    }
+
+    std::shared_ptr<CommonAPI::Proxy> createProxy(const std::string &, const std::string &,
+            const std::string &_instance, std::shared_ptr<CommonAPI::MainLoopContext>) {
+        return create(_instance);
+    }
+
+    bool registerStub(const std::string &, const std::string &, const std::string &,
+            std::shared_ptr<CommonAPI::StubBase>, const CommonAPI::ConnectionId_t &) {
+        return false;
+    }
+
+    bool registerStub(const std::string &, const std::string &, const std::string &,
+            std::shared_ptr<CommonAPI::StubBase>, std::shared_ptr<CommonAPI::MainLoopContext>) {
+        return false;
+    }
+
+    bool unregisterStub(const std::string &, const std::string &, const std::string &) {
+        return false;
+    }
+
+    std::atomic<int> calls_;
+
+private:
+    std::shared_ptr<CommonAPI::Proxy> create(const std::string &_instance) {
+        calls_++;
+        if (accept_(_instance))
+            return std::make_shared<TestProxy>();
+        return nullptr;
+    }
+
+    std::function<bool (const std::string &)> accept_;
+};
+
+// Runs the tasks when told to
+class QueueExecutor : public CommonAPI::Executor {
+public:
+    void execute(std::size_t _key, Task _task) {
+        (void)_key;
+        tasks_.push_back(std::move(_task));
+    }
+
+    std::size_t runAll() {
+        std::size_t itsCount(0);
+        while (!tasks_.empty()) {
+            Task itsTask = std::move(tasks_.front());
+            tasks_.pop_front();
+            itsTask();
+            itsCount++;
+        }
+        return itsCount;
+    }
+
+    std::deque<Task> tasks_;
+};
+
+bool isLibraryLoaded() {
+    auto itsLoaded = static_cast<const bool *>(dlsym(RTLD_DEFAULT, "runtimeTestLibraryLoaded"));
+    return (itsLoaded && *itsLoaded);
+}
+
+} // namespace
+
+class RuntimeTest : public ::testing::Test {
+protected:
+    void SetUp() {
+        runtime_ = CommonAPI::Runtime::get();
+        ASSERT_TRUE(runtime_);
+    }
+
+    std::shared_ptr<CommonAPI::Runtime> runtime_;
+};
+
+// The test configuration maps this proxy to a library that does not
+// register a factory, but makes an already registered one work.
+TEST_F(RuntimeTest, FirstBuildAfterLoadingLibrarySucceeds) {
+    auto itsFactory = std::make_shared<TestFactory>([](const std::string &) {
+        return isLibraryLoaded();
+    });
+    ASSERT_TRUE(runtime_->registerFactory("RuntimeTestLibrary", itsFactory));
+    EXPECT_FALSE(isLibraryLoaded());
+
+    EXPECT_TRUE(runtime_->buildProxy<LibraryProxy>("local", "first"));
+    EXPECT_TRUE(isLibraryLoaded());
+    EXPECT_EQ(2, itsFactory->calls_);
+
+    runtime_->unregisterFactory("RuntimeTestLibrary");
+}
+
+TEST_F(RuntimeTest, RepeatedBuildsAskOnlyTheFactoryThatSucceeded) {
+    auto itsRejecting = std::make_shared<TestFactory>([](const std::string &) { return false; });
+    auto itsAccepting = std::make_shared<TestFactory>([](const std::string &_instance) {
+        return (_instance == "cached");
+    });
+    ASSERT_TRUE(runtime_->registerFactory("RuntimeTestA", itsRejecting));
+    ASSERT_TRUE(runtime_->registerFactory("RuntimeTestB", itsAccepting));
+
+    for (int i = 0; i < 5; i++)
+        EXPECT_TRUE(runtime_->buildProxy<CacheProxy>("local", "cached"));
+    EXPECT_EQ(1, itsRejecting->calls_);
+    EXPECT_EQ(5, itsAccepting->calls_);
+
+    // Registering a factory drops what was remembered
+    auto itsOther = std::make_shared<TestFactory>([](const std::string &) { return false; });
+    ASSERT_TRUE(runtime_->registerFactory("RuntimeTestC", itsOther));
+    EXPECT_TRUE(runtime_->buildProxy<CacheProxy>("local", "cached"));
+    EXPECT_EQ(2, itsRejecting->calls_);
+    EXPECT_EQ(6, itsAccepting->calls_);
+    EXPECT_EQ(0, itsOther->calls_);
+
+    runtime_->unregisterFactory("RuntimeTestA");
+    runtime_->unregisterFactory("RuntimeTestB");
+    runtime_->unregisterFactory("RuntimeTestC");
+}
+
+TEST_F(RuntimeTest, FailedBuildAsksEachFactoryOnce) {
+    auto itsRejecting = std::make_shared<TestFactory>([](const std::string &) { return false; });
+    ASSERT_TRUE(runtime_->registerFactory("RuntimeTestA", itsRejecting));
+
+    // No library, no default factory
+    EXPECT_FALSE(runtime_->buildProxy<CacheProxy>("local", "missing"));
+    EXPECT_EQ(1, itsRejecting->calls_);
+    EXPECT_FALSE(runtime_->buildProxy<CacheProxy>("local", "missing"));
+    EXPECT_EQ(2, itsRejecting->calls_);
+
+    runtime_->unregisterFactory("RuntimeTestA");
+}
+
+TEST_F(RuntimeTest, AsyncBuildsKeepTheRuntimeAlive) {
+    auto itsRuntime = std::make_shared<CommonAPI::Runtime>();
+    auto itsFactory = std::make_shared<TestFactory>([](const std::string &_instance) {
+        return (_instance == "cached");
+    });
+    ASSERT_TRUE(itsRuntime->registerFactory("RuntimeTestA", itsFactory));
+
+    auto itsExecutor = std::make_shared<QueueExecutor>();
+    auto itsProxy = itsRuntime->buildProxyAsync<CacheProxy>("local", "cached",
+                                                            CommonAPI::DEFAULT_CONNECTION_ID, itsExecutor);
+    auto itsContext = std::make_shared<CommonAPI::MainLoopContext>("RuntimeTest");
+    auto itsMissing = itsRuntime->buildProxyAsync<CacheProxy>("local", "missing", itsContext, itsExecutor);
+    auto itsProxies = itsRuntime->buildProxiesAsync(
+        { CommonAPI::ProxyRequest("local", "test.Cache:v1_0", "cached") }, nullptr, itsExecutor);
+
+    // Run after the caller released the runtime
+    std::weak_ptr<CommonAPI::Runtime> itsWeakRuntime(itsRuntime);
+    itsRuntime.reset();
+    EXPECT_FALSE(itsWeakRuntime.expired());
+
+    EXPECT_EQ(3u, itsExecutor->runAll());
+    EXPECT_TRUE(itsWeakRuntime.expired());
+    auto itsBuilt = itsProxy.get();
+    ASSERT_TRUE(itsBuilt);
+    EXPECT_TRUE(itsBuilt->proxy_);
+    EXPECT_FALSE(itsMissing.get());
+    ASSERT_EQ(1u, itsProxies.size());
+    EXPECT_TRUE(itsProxies[0].get());
+    EXPECT_EQ(3, itsFactory->calls_);
+}
+
+TEST_F(RuntimeTest, AsyncBuildUsesThreadPoolWithoutExecutor) {
+    auto itsFactory = std::make_shared<TestFactory>([](const std::string &_instance) {
+        return (_instance == "cached");
+    });
+    ASSERT_TRUE(runtime_->registerFactory("RuntimeTestA", itsFactory));
+
+    auto itsProxy = runtime_->buildProxyAsync<CacheProxy>("local", "cached").get();
+    ASSERT_TRUE(itsProxy);
+    EXPECT_TRUE(itsProxy->proxy_);
+    EXPECT_FALSE(runtime_->buildProxyAsync<CacheProxy>("local", "missing").get());
+
+    runtime_->unregisterFactory("RuntimeTestA");
+}
+
+TEST_F(RuntimeTest, BulkBuildReportsEachProxyInRequestOrder) {
+    auto itsFactory = std::make_shared<TestFactory>([](const std::string &_instance) {
+        return (_instance != "missing");
+    });
+    ASSERT_TRUE(runtime_->registerFactory("RuntimeTestA", itsFactory));
+
+    auto itsContext = std::make_shared<CommonAPI::MainLoopContext>("RuntimeTest");
+    std::vector<CommonAPI::ProxyRequest> itsRequests {
+        CommonAPI::ProxyRequest("local", "test.Cache:v1_0", "first"),
+        CommonAPI::ProxyRequest("local", "test.Cache:v1_0", "missing"),
+        CommonAPI::ProxyRequest("local", "test.Cache:v1_0", "third", itsContext)
+    };
+
+    // A partial failure is reported by an empty proxy
+    std::atomic<int> itsCallbacks(0);
+    std::promise<std::vector<std::shared_ptr<CommonAPI::Proxy>>> itsBuilt;
+    auto itsFutures = runtime_->buildProxiesAsync(itsRequests,
+        [&](const std::vector<std::shared_ptr<CommonAPI::Proxy>> &_proxies) {
+            itsCallbacks++;
+            itsBuilt.set_value(_proxies);
+        });
+
+    auto itsProxies = itsBuilt.get_future().get();
+    ASSERT_EQ(3u, itsProxies.size());
+    EXPECT_TRUE(itsProxies[0]);
+    EXPECT_FALSE(itsProxies[1]);
+    EXPECT_TRUE(itsProxies[2]);
+    ASSERT_EQ(3u, itsFutures.size());
+    for (std::size_t i = 0; i < itsFutures.size(); i++)
+        EXPECT_EQ(itsProxies[i], itsFutures[i].get());
+    EXPECT_EQ(1, itsCallbacks);
+    EXPECT_EQ(3, itsFactory->calls_);
+
+    // An empty batch is reported at once
+    bool isCalled(false);
+    EXPECT_TRUE(runtime_->buildProxiesAsync({},
+        [&](const std::vector<std::shared_ptr<CommonAPI::Proxy>> &_proxies) {
+            isCalled = _proxies.empty();
+        }).empty());
+    EXPECT_TRUE(isCalled);
+
+    runtime_->unregisterFactory("RuntimeTestA");
+}
@@ -0,0 +1,22 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <CommonAPI/Export.hpp>
+
+// Stands in for a binding library that makes a factory work once its
+// static constructors have run, without registering a factory itself.
+extern "C" {
+COMMONAPI_EXPORT bool runtimeTestLibraryLoaded = false;
+}
+
+namespace {
+
+struct Initializer {
+    Initializer() {
+        runtimeTestLibraryLoaded = true;
+    }
+} theInitializer__;
+
+} // namespace
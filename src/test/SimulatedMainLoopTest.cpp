@@ -0,0 +1,279 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CommonAPI/CommonAPI.hpp>
+#include <CommonAPI/SimulatedMainLoop.hpp>
+
+namespace {
+
+// Periodic, remembers the simulated times of its dispatches
+class PeriodicTimeout : public CommonAPI::Timeout {
+public:
+    PeriodicTimeout(int64_t _interval)
+        : interval_(_interval), readyTime_(CommonAPI::getCurrentTimeInMs() + _interval),
+          isPeriodic_(true) {}
+
+    bool dispatch() {
+        int64_t itsNow = CommonAPI::getCurrentTimeInMs();
+        dispatches_.push_back(itsNow);
+        readyTime_ = itsNow + interval_;
+        return isPeriodic_;
+    }
+
+    int64_t getTimeoutInterval() const {
+        return interval_;
+    }
+
+    int64_t getReadyTime() const {
+        return readyTime_;
+    }
+
+    int64_t interval_;
+    int64_t readyTime_;
+    bool isPeriodic_;
+    std::vector<int64_t> dispatches_;
+};
+
+class OnceSource : public CommonAPI::DispatchSource {
+public:
+    OnceSource() : isReady_(true), dispatches_(0) {}
+
+    bool prepare(int64_t &_timeout) {
+        _timeout = CommonAPI::TIMEOUT_INFINITE;
+        return isReady_;
+    }
+
+    bool check() {
+        return isReady_;
+    }
+
+    bool dispatch() {
+        isReady_ = false;
+        dispatches_++;
+        if (action_)
+            action_();
+        return false;
+    }
+
+    bool isReady_;
+    int dispatches_;
+    std::function<void()> action_;
+};
+
+} // namespace
+
+class SimulatedMainLoopTest : public ::testing::Test {
+protected:
+    void SetUp() {
+        clock_ = std::make_shared<CommonAPI::SimulatedClock>(START);
+        CommonAPI::setClock(clock_);
+        context_ = std::make_shared<CommonAPI::MainLoopContext>("SimulatedMainLoopTest");
+    }
+
+    void TearDown() {
+        CommonAPI::setClock(nullptr);
+    }
+
+    static constexpr int64_t START = 1000;
+
+    std::shared_ptr<CommonAPI::SimulatedClock> clock_;
+    std::shared_ptr<CommonAPI::MainLoopContext> context_;
+};
+
+TEST_F(SimulatedMainLoopTest, RejectsMissingContextOrClock) {
+    EXPECT_THROW(CommonAPI::SimulatedMainLoop(context_, nullptr), std::invalid_argument);
+    EXPECT_THROW(CommonAPI::SimulatedMainLoop(nullptr, clock_), std::invalid_argument);
+}
+
+TEST_F(SimulatedMainLoopTest, DispatchesPeriodicTimeoutsAtTheirSimulatedTimes) {
+    CommonAPI::SimulatedMainLoop itsLoop(context_, clock_);
+    itsLoop.setTracing(true);
+
+    std::vector<std::unique_ptr<PeriodicTimeout>> itsTimeouts;
+    for (int64_t i : { 7, 100, 999 }) {
+        itsTimeouts.emplace_back(new PeriodicTimeout(i));
+        context_->registerTimeoutSource(itsTimeouts.back().get());
+    }
+
+    const int64_t itsDuration(600 * 1000);
+    std::size_t itsDispatches = itsLoop.runFor(std::chrono::milliseconds(itsDuration));
+    EXPECT_EQ(START + itsDuration, CommonAPI::getCurrentTimeInMs());
+
+    std::size_t itsExpected(0);
+    for (auto &t : itsTimeouts) {
+        ASSERT_EQ(static_cast<std::size_t>(itsDuration / t->interval_), t->dispatches_.size());
+        for (std::size_t i = 0; i < t->dispatches_.size(); i++)
+            ASSERT_EQ(START + static_cast<int64_t>(i + 1) * t->interval_, t->dispatches_[i]);
+        itsExpected += t->dispatches_.size();
+    }
+    EXPECT_EQ(itsExpected, itsDispatches);
+
+    auto itsTrace = itsLoop.getTrace();
+    ASSERT_EQ(itsDispatches, itsTrace.size());
+    for (std::size_t i = 1; i < itsTrace.size(); i++)
+        ASSERT_LE(itsTrace[i - 1].time_, itsTrace[i].time_);
+
+    for (auto &t : itsTimeouts)
+        context_->deregisterTimeoutSource(t.get());
+}
+
+TEST_F(SimulatedMainLoopTest, RunPendingDoesNotAdvanceTime) {
+    CommonAPI::SimulatedMainLoop itsLoop(context_, clock_);
+    OnceSource itsSource;
+    PeriodicTimeout itsTimeout(10);
+    context_->registerDispatchSource(&itsSource);
+    context_->registerTimeoutSource(&itsTimeout);
+
+    EXPECT_EQ(1u, itsLoop.runPending());
+    EXPECT_EQ(1, itsSource.dispatches_);
+    EXPECT_TRUE(itsTimeout.dispatches_.empty());
+    EXPECT_EQ(START, CommonAPI::getCurrentTimeInMs());
+
+    context_->deregisterDispatchSource(&itsSource);
+    context_->deregisterTimeoutSource(&itsTimeout);
+}
+
+TEST_F(SimulatedMainLoopTest, TimeAdvancesPastTimeoutThatStaysDue) {
+    CommonAPI::SimulatedMainLoop itsLoop(context_, clock_);
+
+    // Stays due after each dispatch
+    PeriodicTimeout itsTimeout(10);
+    itsTimeout.interval_ = 0;
+    context_->registerTimeoutSource(&itsTimeout);
+
+    itsLoop.runUntil(START + 50);
+    EXPECT_EQ(START + 50, CommonAPI::getCurrentTimeInMs());
+    EXPECT_FALSE(itsTimeout.dispatches_.empty());
+
+    context_->deregisterTimeoutSource(&itsTimeout);
+}
+
+TEST_F(SimulatedMainLoopTest, TimeoutIsOnlyRemovedFromTheLoopWhenItsDispatchReturnsFalse) {
+    CommonAPI::SimulatedMainLoop itsLoop(context_, clock_);
+    int itsDeregistrations(0);
+    auto itsSubscription = context_->subscribeForTimeouts(
+        [](CommonAPI::Timeout *, const CommonAPI::DispatchPriority) {},
+        [&](CommonAPI::Timeout *) { itsDeregistrations++; });
+
+    PeriodicTimeout itsTimeout(10);
+    itsTimeout.isPeriodic_ = false;
+    context_->registerTimeoutSource(&itsTimeout);
+    itsLoop.runUntil(START + 100);
+    EXPECT_EQ((std::vector<int64_t>{ START + 10 }), itsTimeout.dispatches_);
+    EXPECT_EQ(0, itsDeregistrations);
+
+    // May be registered again
+    itsTimeout.readyTime_ = START + 150;
+    context_->registerTimeoutSource(&itsTimeout);
+    itsLoop.runUntil(START + 200);
+    EXPECT_EQ((std::vector<int64_t>{ START + 10, START + 150 }), itsTimeout.dispatches_);
+
+    context_->unsubscribeForTimeouts(itsSubscription);
+}
+
+TEST_F(SimulatedMainLoopTest, RegisteringAgainReschedulesEarlierReadyTime) {
+    CommonAPI::SimulatedMainLoop itsLoop(context_, clock_);
+    PeriodicTimeout itsTimeout(10000);
+    context_->registerTimeoutSource(&itsTimeout);
+
+    // Not polled by default
+    itsTimeout.readyTime_ = START + 50;
+    itsLoop.runUntil(START + 100);
+    EXPECT_TRUE(itsTimeout.dispatches_.empty());
+
+    itsTimeout.readyTime_ = START + 150;
+    context_->registerTimeoutSource(&itsTimeout);
+    itsLoop.runUntil(START + 200);
+    ASSERT_EQ(1u, itsTimeout.dispatches_.size());
+    EXPECT_EQ(START + 150, itsTimeout.dispatches_[0]);
+
+    context_->deregisterTimeoutSource(&itsTimeout);
+}
+
+TEST_F(SimulatedMainLoopTest, PollingPicksUpEarlierReadyTime) {
+    CommonAPI::SimulatedMainLoop itsLoop(context_, clock_);
+    itsLoop.setTimeoutPolling(true);
+    PeriodicTimeout itsTimeout(10000);
+    context_->registerTimeoutSource(&itsTimeout);
+
+    itsLoop.runUntil(START + 20);
+    EXPECT_TRUE(itsTimeout.dispatches_.empty());
+
+    // Moved earlier without registering again
+    itsTimeout.readyTime_ = START + 50;
+    itsLoop.runUntil(START + 100);
+    ASSERT_EQ(1u, itsTimeout.dispatches_.size());
+    EXPECT_EQ(START + 50, itsTimeout.dispatches_[0]);
+
+    context_->deregisterTimeoutSource(&itsTimeout);
+}
+
+TEST_F(SimulatedMainLoopTest, InstrumentationRecordsDispatchesAndBacklog) {
+    context_->enableInstrumentation();
+    std::unique_ptr<CommonAPI::SimulatedMainLoop> itsLoop(new CommonAPI::SimulatedMainLoop(context_, clock_));
+
+    // Each dispatch takes 5ms of simulated time
+    OnceSource itsSources[2];
+    for (auto &s : itsSources) {
+        s.action_ = [this]() { clock_->advance(std::chrono::milliseconds(5)); };
+        context_->registerDispatchSource(&s);
+    }
+    PeriodicTimeout itsTimeout(100);
+    context_->registerTimeoutSource(&itsTimeout, CommonAPI::DispatchPriority::HIGH);
+
+    itsLoop->runUntil(START + 150);
+    ASSERT_EQ(1u, itsTimeout.dispatches_.size());
+
+    CommonAPI::MainLoopStatistics itsStatistics;
+    ASSERT_TRUE(context_->getStatistics(itsStatistics));
+    EXPECT_EQ("SimulatedMainLoopTest", itsStatistics.name_);
+    ASSERT_EQ(3u, itsStatistics.elements_.size());
+    for (auto &e : itsStatistics.elements_) {
+        EXPECT_EQ(1u, e.dispatches_);
+        EXPECT_EQ(0u, e.moreToDispatch_);
+        EXPECT_EQ(1u, e.duration_.count_);
+        if (e.element_ == &itsTimeout) {
+            EXPECT_EQ(CommonAPI::DispatchStatistics::Kind::TIMEOUT, e.kind_);
+            EXPECT_EQ(CommonAPI::DispatchPriority::HIGH, e.priority_);
+            EXPECT_EQ(0u, e.duration_.max_);
+        } else {
+            EXPECT_EQ(CommonAPI::DispatchStatistics::Kind::DISPATCH_SOURCE, e.kind_);
+            EXPECT_EQ(5000000u, e.duration_.max_);
+        }
+    }
+
+    // Both sources were ready at once, the second one waited for the first
+    auto &itsDefault = itsStatistics.priorities_[static_cast<std::size_t>(CommonAPI::DispatchPriority::DEFAULT)];
+    EXPECT_EQ(0u, itsDefault.backlog_);
+    EXPECT_EQ(2u, itsDefault.maxBacklog_);
+    EXPECT_EQ(2u, itsDefault.starvation_.count_);
+    EXPECT_EQ(5000000u, itsDefault.starvation_.max_);
+    auto &itsHigh = itsStatistics.priorities_[static_cast<std::size_t>(CommonAPI::DispatchPriority::HIGH)];
+    EXPECT_EQ(1u, itsHigh.starvation_.count_);
+
+    // Registered by name
+    auto itsNamed = CommonAPI::MainLoopContext::getStatistics("SimulatedMainLoopTest");
+    ASSERT_EQ(1u, itsNamed.size());
+    EXPECT_EQ(3u, itsNamed[0].elements_.size());
+
+    context_->deregisterTimeoutSource(&itsTimeout);
+    for (auto &s : itsSources)
+        context_->deregisterDispatchSource(&s);
+    ASSERT_TRUE(context_->getStatistics(itsStatistics));
+    EXPECT_TRUE(itsStatistics.elements_.empty());
+
+    itsLoop.reset();
+    context_.reset();
+    EXPECT_TRUE(CommonAPI::MainLoopContext::getStatistics("SimulatedMainLoopTest").empty());
+}
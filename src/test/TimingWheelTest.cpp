@@ -0,0 +1,153 @@
+// Copyright (C) 2026 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CommonAPI/TimingWheel.hpp>
+
+namespace {
+
+struct Element {
+    Element(int64_t _readyTime) : readyTime_(_readyTime), expired_(-1) {}
+
+    CommonAPI::TimingWheel<Element *>::Timer timer_;
+    int64_t readyTime_;
+    int64_t expired_;
+};
+
+// Advances to the next ready time until the wheel is empty
+std::size_t runToCompletion(CommonAPI::TimingWheel<Element *> &_wheel) {
+    std::size_t itsSteps(0);
+    while (_wheel.size() > 0) {
+        int64_t itsNow = _wheel.getNextReadyTime();
+        _wheel.advance(itsNow, [itsNow](Element *_element) {
+            EXPECT_LT(_element->expired_, 0);
+            _element->expired_ = itsNow;
+        });
+        itsSteps++;
+    }
+    return itsSteps;
+}
+
+} // namespace
+
+TEST(TimingWheelTest, ExpiresAtReadyTimeOnEachLevel) {
+    const int64_t itsStart(1000);
+    CommonAPI::TimingWheel<Element *> itsWheel(itsStart);
+
+    // Level 0 to 3, the last one cascades three times
+    std::vector<std::unique_ptr<Element>> itsElements;
+    for (int64_t d : { int64_t(0), int64_t(1), int64_t(255), int64_t(256), int64_t(70000),
+                       int64_t(20000000), int64_t(3000000000) }) {
+        itsElements.emplace_back(new Element(itsStart + d));
+        itsWheel.schedule(itsElements.back()->timer_, itsElements.back().get(), itsStart + d);
+    }
+    EXPECT_EQ(itsElements.size(), itsWheel.size());
+
+    runToCompletion(itsWheel);
+    for (auto &e : itsElements)
+        EXPECT_EQ(e->readyTime_, e->expired_);
+}
+
+TEST(TimingWheelTest, ParksElementsBeyondTheLastLevel) {
+    // More than 2^32ms ahead, thus parked and rescheduled when cascaded
+    const int64_t itsStart(12345);
+    const int64_t itsReadyTime(itsStart + (int64_t(1) << 33) + 77);
+    CommonAPI::TimingWheel<Element *> itsWheel(itsStart);
+
+    Element itsElement(itsReadyTime);
+    itsWheel.schedule(itsElement.timer_, &itsElement, itsReadyTime);
+    EXPECT_LE(itsWheel.getNextReadyTime(), itsReadyTime);
+
+    // Advancing to shortly before the ready time must not expire it
+    itsWheel.advance(itsReadyTime - 1, [](Element *_element) { _element->expired_ = 0; });
+    EXPECT_LT(itsElement.expired_, 0);
+    EXPECT_EQ(itsReadyTime, itsWheel.getNextReadyTime());
+
+    runToCompletion(itsWheel);
+    EXPECT_EQ(itsReadyTime, itsElement.expired_);
+}
+
+TEST(TimingWheelTest, SchedulingInThePastExpiresWithNextAdvance) {
+    CommonAPI::TimingWheel<Element *> itsWheel(500);
+    Element itsElement(100);
+    itsWheel.schedule(itsElement.timer_, &itsElement, itsElement.readyTime_);
+    EXPECT_EQ(500, itsWheel.getNextReadyTime());
+
+    itsWheel.advance(500, [](Element *_element) { _element->expired_ = 500; });
+    EXPECT_EQ(500, itsElement.expired_);
+    EXPECT_FALSE(itsElement.timer_.isScheduled());
+}
+
+TEST(TimingWheelTest, CancelledAndRescheduledElements) {
+    CommonAPI::TimingWheel<Element *> itsWheel(0);
+    Element itsCancelled(300), itsMoved(70000), itsRepeated(10);
+
+    itsWheel.schedule(itsCancelled.timer_, &itsCancelled, itsCancelled.readyTime_);
+    itsWheel.schedule(itsMoved.timer_, &itsMoved, itsMoved.readyTime_);
+    itsWheel.schedule(itsRepeated.timer_, &itsRepeated, itsRepeated.readyTime_);
+    itsWheel.cancel(itsCancelled.timer_);
+    itsWheel.cancel(itsCancelled.timer_);
+    itsMoved.readyTime_ = 20;
+    itsWheel.schedule(itsMoved.timer_, &itsMoved, itsMoved.readyTime_);
+    EXPECT_EQ(2u, itsWheel.size());
+
+    // An expired element may be scheduled again from the callback
+    int itsRepetitions(0);
+    itsWheel.advance(100000, [&](Element *_element) {
+        if (_element == &itsRepeated && ++itsRepetitions < 5) {
+            itsRepeated.readyTime_ += 10;
+            itsWheel.schedule(itsRepeated.timer_, &itsRepeated, itsRepeated.readyTime_);
+        } else {
+            _element->expired_ = 0;
+        }
+    });
+
+    EXPECT_LT(itsCancelled.expired_, 0);
+    EXPECT_EQ(0, itsMoved.expired_);
+    EXPECT_EQ(5, itsRepetitions);
+    EXPECT_EQ(0u, itsWheel.size());
+}
+
+TEST(TimingWheelTest, RandomScheduleExpiresEachElementOnceAndNotEarly) {
+    std::mt19937_64 itsRandom(1);
+    const int64_t itsStart(static_cast<int64_t>(itsRandom() % 1000000000));
+    CommonAPI::TimingWheel<Element *> itsWheel(itsStart);
+
+    std::vector<std::unique_ptr<Element>> itsElements;
+    for (int i = 0; i < 5000; i++) {
+        const int64_t itsRanges[] = { 300, 70000, 20000000, 6000000000 };
+        int64_t itsReadyTime = itsStart + static_cast<int64_t>(itsRandom() % uint64_t(itsRanges[i % 4]));
+        itsElements.emplace_back(new Element(itsReadyTime));
+        itsWheel.schedule(itsElements.back()->timer_, itsElements.back().get(), itsReadyTime);
+    }
+    for (std::size_t i = 0; i < itsElements.size(); i += 7)
+        itsWheel.cancel(itsElements[i]->timer_);
+
+    // Mixes small and large steps, not aligned to the ready times
+    int64_t itsNow(itsStart);
+    while (itsWheel.size() > 0) {
+        int64_t itsNext = itsWheel.getNextReadyTime();
+        ASSERT_GE(itsNext, itsNow);
+        itsNow += static_cast<int64_t>(itsRandom() % 3 ? 1 + itsRandom() % 50 : 1 + itsRandom() % 100000000);
+        itsWheel.advance(itsNow, [itsNow](Element *_element) {
+            EXPECT_LE(_element->readyTime_, itsNow);
+            EXPECT_LT(_element->expired_, 0);
+            _element->expired_ = itsNow;
+        });
+    }
+
+    for (std::size_t i = 0; i < itsElements.size(); i++) {
+        if (i % 7 == 0)
+            EXPECT_LT(itsElements[i]->expired_, 0);
+        else
+            EXPECT_GE(itsElements[i]->expired_, itsElements[i]->readyTime_);
+    }
+}